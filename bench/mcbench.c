@@ -0,0 +1,603 @@
+#include "mccluskey.h"
+#include "mcinput.h"
+#include "mcpool.h"
+#include "mcsimd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+///
+///	@brief Default suite, cases are generator specifications
+///	"FAMILY:VARIABLES[:DENSITY[:DONTCARES[:OUTPUTS]]]". The exact engine searches all
+///	minimum covers, denser functions and larger cyclic cores are left to --case
+///
+static const char * const McCluskeyBench_suite[] = {
+	"random:8:0.3:0:1",
+	"random:10:0.1:0.1:2",
+	"random:12:0.05:0:1",
+	"random:14:0.05:0:1",
+	"random:16:0.01:0.2:1",
+	"random:20:0.001:0:1",
+	"random:24:0.0001:0:1",
+	"random:28:0.00001:0:1",
+	"dontcare:10:0.1:0.6:1",
+	"dontcare:12:0.05:0.7:1",
+	"dontcare:14:0.02:0.6:1",
+	"parity:10",
+	"majority:9",
+	"adder:2",
+	"comparator:5",
+	"cyclic:4",
+	"cyclic:6",
+};
+
+#define MCCLUSKEYBENCH_SUITE (sizeof McCluskeyBench_suite / sizeof McCluskeyBench_suite[0])
+
+// Largest number of variables whose truth table is enumerated minterm by minterm
+#define MCCLUSKEYBENCH_MAX_DENSE 20
+
+///
+///	@brief Generated truth table in text format
+///
+typedef struct McCluskeyBenchTable
+{
+	char * text;
+	size_t len, cap;
+	size_t n_rows;
+	uint8_t n_vars, n_outputs;
+	uint64_t rng;
+
+} McCluskeyBenchTable_t;
+
+///
+///	@brief Timings of 1 run of a case
+///
+typedef struct McCluskeyBenchRun
+{
+	double ingest, sort, setup, optimise, total;
+	double * layers;
+	size_t * layerNodes;
+	size_t n_layers, cap_layers;
+	size_t n_covers, coverSize;
+
+} McCluskeyBenchRun_t;
+
+static inline uint64_t McCluskeyBench_random(McCluskeyBenchTable_t * restrict This)
+{
+	uint64_t z = (This->rng += UINT64_C(0x9e3779b97f4a7c15));
+	z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+	z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+	return z ^ (z >> 31);
+}
+///
+///	@returns Uniform random number in [0, 1)
+///
+static inline double McCluskeyBench_uniform(McCluskeyBenchTable_t * restrict This)
+{
+	return (double)(McCluskeyBench_random(This) >> 11) * (1.0 / 9007199254740992.0);
+}
+static inline double McCluskeyBench_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+///
+///	@brief Appends 1 row to the table, rows without any defined output are skipped
+///	@param minterm Bits of the argument vector, bit i being variable i from the right
+///	@param values Null-terminated values, 1 character per output
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyBench_addRow(McCluskeyBenchTable_t * restrict This, uint64_t minterm, const char * restrict values)
+{
+	if (strspn(values, "0") == This->n_outputs)
+	{
+		return true;
+	}
+	const size_t rowLen = (size_t)This->n_vars + 1 + This->n_outputs + 1;
+	if ((This->len + rowLen + 1) > This->cap)
+	{
+		size_t newcap = (This->len + rowLen + 1) * 2;
+		char * mem = realloc(This->text, newcap);
+		if (mem == NULL)
+		{
+			return false;
+		}
+		This->text = mem;
+		This->cap  = newcap;
+	}
+	char * row = &This->text[This->len];
+	for (uint8_t i = 0; i < This->n_vars; ++i)
+	{
+		row[This->n_vars - 1 - i] = ((minterm >> i) & 1) ? '1' : '0';
+	}
+	row[This->n_vars] = ' ';
+	memcpy(&row[This->n_vars + 1], values, This->n_outputs);
+	row[rowLen - 1] = '\n';
+	This->len += rowLen;
+	This->text[This->len] = '\0';
+	++This->n_rows;
+	return true;
+}
+///
+///	@brief Random values of a row, each output is '1' with the given probability,
+///	otherwise '-' with the given probability of don't cares
+///
+static void McCluskeyBench_randomValues(McCluskeyBenchTable_t * restrict This, double dontcares, char * restrict values)
+{
+	for (uint8_t o = 0; o < This->n_outputs; ++o)
+	{
+		const double r = McCluskeyBench_uniform(This);
+		values[o] = (r < dontcares) ? '-' : ((r < 0.5 + dontcares / 2) ? '1' : '0');
+	}
+	values[This->n_outputs] = '\0';
+	if (strspn(values, "0") == This->n_outputs)
+	{
+		values[McCluskeyBench_random(This) % This->n_outputs] = '1';
+	}
+}
+
+///
+///	@brief Generates a truth table from a specification
+///	"FAMILY:VARIABLES[:DENSITY[:DONTCARES[:OUTPUTS]]]". Families:
+///	- random: each minterm is a row with probability DENSITY, sampled at random above
+///	  MCCLUSKEYBENCH_MAX_DENSE variables, outputs are '-' with probability DONTCARES
+///	- dontcare: random with DONTCARES defaulting to 0.6
+///	- parity: odd number of ones
+///	- majority: more ones than zeros
+///	- adder: VARIABLES-bit adder, 2 * VARIABLES inputs and VARIABLES + 1 outputs
+///	- comparator: a > b of 2 VARIABLES-bit numbers
+///	- cyclic: not all variables equal, no prime implicant is essential
+///	@param This Pointer to table object
+///	@param spec Specification string
+///	@param seed Seed of random numbers
+///	@returns Whether the specification was valid and the table was generated
+///
+static bool McCluskeyBench_generate(McCluskeyBenchTable_t * restrict This, const char * restrict spec, uint64_t seed)
+{
+	memset(This, 0, sizeof(McCluskeyBenchTable_t));
+	This->rng = seed;
+
+	char family[32];
+	unsigned n = 0, n_outputs = 1;
+	double density = 0.5, dontcares = -1.0;
+	const int n_fields = sscanf(spec, "%31[a-z]:%u:%lf:%lf:%u", family, &n, &density, &dontcares, &n_outputs);
+	if (n_fields < 2 || n == 0 || n_outputs == 0 || n_outputs > MCCLUSKEYVAL_MAX_OUTPUTS)
+	{
+		return false;
+	}
+	if (dontcares < 0.0)
+	{
+		dontcares = (strcmp(family, "dontcare") == 0) ? 0.6 : 0.0;
+	}
+
+	const bool adder = strcmp(family, "adder") == 0, comparator = strcmp(family, "comparator") == 0;
+	const unsigned n_vars = (adder || comparator) ? 2 * n : n;
+	if (n_vars > MCCLUSKEYVAL_MAX_ARGVEC || n_vars > 63)
+	{
+		return false;
+	}
+	This->n_vars    = (uint8_t)n_vars;
+	This->n_outputs = adder ? (uint8_t)(n + 1) : ((strcmp(family, "random") == 0 ||
+		strcmp(family, "dontcare") == 0) ? (uint8_t)n_outputs : 1);
+
+	char values[MCCLUSKEYVAL_MAX_OUTPUTS + 1];
+	values[This->n_outputs] = '\0';
+	const uint64_t size = UINT64_C(1) << n_vars, half = UINT64_C(1) << n;
+	if (strcmp(family, "random") == 0 || strcmp(family, "dontcare") == 0)
+	{
+		if (n_vars > MCCLUSKEYBENCH_MAX_DENSE)
+		{
+			const uint64_t n_rows = (uint64_t)(density * (double)size);
+			for (uint64_t i = 0; i < n_rows; ++i)
+			{
+				McCluskeyBench_randomValues(This, dontcares, values);
+				if (McCluskeyBench_addRow(This, McCluskeyBench_random(This) & (size - 1), values) == false)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+		for (uint64_t m = 0; m < size; ++m)
+		{
+			if (McCluskeyBench_uniform(This) < density)
+			{
+				McCluskeyBench_randomValues(This, dontcares, values);
+				if (McCluskeyBench_addRow(This, m, values) == false)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	else if (n_vars > MCCLUSKEYBENCH_MAX_DENSE)
+	{
+		return false;
+	}
+
+	for (uint64_t m = 0; m < size; ++m)
+	{
+		const int ones = __builtin_popcountll(m);
+		if (strcmp(family, "parity") == 0)
+		{
+			values[0] = (ones & 1) ? '1' : '0';
+		}
+		else if (strcmp(family, "majority") == 0)
+		{
+			values[0] = ((unsigned)ones * 2 > n_vars) ? '1' : '0';
+		}
+		else if (strcmp(family, "cyclic") == 0)
+		{
+			values[0] = (m != 0 && m != (size - 1)) ? '1' : '0';
+		}
+		else if (comparator)
+		{
+			values[0] = ((m >> n) > (m & (half - 1))) ? '1' : '0';
+		}
+		else if (adder)
+		{
+			const uint64_t sum = (m >> n) + (m & (half - 1));
+			for (unsigned o = 0; o <= n; ++o)
+			{
+				values[o] = ((sum >> (n - o)) & 1) ? '1' : '0';
+			}
+		}
+		else
+		{
+			return false;
+		}
+		if (McCluskeyBench_addRow(This, m, values) == false)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+static void McCluskeyBench_freeTable(McCluskeyBenchTable_t * restrict This)
+{
+	free(This->text);
+	memset(This, 0, sizeof(McCluskeyBenchTable_t));
+}
+
+///
+///	@brief Solves a generated table once, timing every phase separately
+///	@param table Pointer to generated table
+///	@param ctx Pointer to context holding the solver options
+///	@param run Pointer to run object receiving the timings
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyBench_run(const McCluskeyBenchTable_t * restrict table, McCluskeyCtx_t * restrict ctx, McCluskeyBenchRun_t * restrict run)
+{
+	run->n_layers = 0;
+	McCluskeyVals_t vals;
+	McCluskeyVals_make(&vals, ctx);
+
+	const double start = McCluskeyBench_now();
+	size_t n_invalid;
+	bool sorted;
+	if (McCluskeyInput_parseBuffer(ctx, table->text, table->len, ctx->n_threads, &vals, &n_invalid, &sorted) == false ||
+		n_invalid > 0)
+	{
+		McCluskeyVals_destroy(&vals);
+		return false;
+	}
+	double t = McCluskeyBench_now();
+	run->ingest = t - start;
+
+	if (McCluskeyVals_sort(&vals) == false)
+	{
+		McCluskeyVals_destroy(&vals);
+		return false;
+	}
+	run->sort = McCluskeyBench_now() - t;
+
+	t = McCluskeyBench_now();
+	McCluskeySolver_t solver;
+	if (McCluskeySolver_make(&solver, ctx, &vals) == false)
+	{
+		McCluskeyVals_destroy(&vals);
+		return false;
+	}
+	run->setup = McCluskeyBench_now() - t;
+
+	bool success = true, more = true;
+	while (success && more)
+	{
+		// The last call adds a layer without new nodes
+		t = McCluskeyBench_now();
+		success = McCluskeySolver_solveLayer(&solver, &more);
+		const double elapsed = McCluskeyBench_now() - t;
+		if (success == false)
+		{
+			break;
+		}
+		else if (run->n_layers >= run->cap_layers)
+		{
+			const size_t newcap = (run->n_layers + 1) * 2;
+			double * layers = realloc(run->layers, sizeof(double) * newcap);
+			size_t * nodes  = (layers == NULL) ? NULL : realloc(run->layerNodes, sizeof(size_t) * newcap);
+			success = (nodes != NULL);
+			run->layers = (layers != NULL) ? layers : run->layers;
+			if (success == false)
+			{
+				break;
+			}
+			run->layerNodes = nodes;
+			run->cap_layers = newcap;
+		}
+		run->layers[run->n_layers]     = elapsed;
+		run->layerNodes[run->n_layers] = McCluskeySolver_getLayer(&solver)->n_vals;
+		++run->n_layers;
+	}
+
+	size_t newLayers = 0;
+	t = McCluskeyBench_now();
+	success = success && McCluskeySolver_optimiseLayer(&solver, &newLayers);
+	const double end = McCluskeyBench_now();
+	run->optimise  = end - t;
+	run->total     = end - start;
+	run->n_covers  = newLayers;
+	run->coverSize = success ? McCluskeySolver_getLayer(&solver)->n_vals : 0;
+
+	McCluskeySolver_destroy(&solver);
+	McCluskeyVals_destroy(&vals);
+	return success;
+}
+
+static void McCluskeyBench_csvRow(
+	FILE * restrict out,
+	const char * restrict spec,
+	const McCluskeyBenchTable_t * restrict table,
+	size_t n_threads,
+	size_t repeat,
+	const char * restrict phase,
+	size_t layer,
+	double seconds,
+	size_t nodes
+)
+{
+	fprintf(out, "%s,%u,%u,%zu,%zu,%zu,%s,%zu,%.9f,%zu\n",
+		spec, table->n_vars, table->n_outputs, table->n_rows, n_threads, repeat, phase, layer, seconds, nodes);
+}
+static void McCluskeyBench_write(
+	FILE * restrict out,
+	bool json,
+	const char * restrict spec,
+	const McCluskeyBenchTable_t * restrict table,
+	size_t n_threads,
+	size_t repeat,
+	const McCluskeyBenchRun_t * restrict run
+)
+{
+	if (json)
+	{
+		fprintf(out, "{\"case\":\"%s\",\"variables\":%u,\"outputs\":%u,\"rows\":%zu,\"threads\":%zu,\"repeat\":%zu,"
+			"\"ingest\":%.9f,\"sort\":%.9f,\"setup\":%.9f,\"layers\":[",
+			spec, table->n_vars, table->n_outputs, table->n_rows, n_threads, repeat, run->ingest, run->sort, run->setup);
+		for (size_t i = 0; i < run->n_layers; ++i)
+		{
+			fprintf(out, "%s{\"seconds\":%.9f,\"nodes\":%zu}", (i > 0) ? "," : "", run->layers[i], run->layerNodes[i]);
+		}
+		fprintf(out, "],\"optimise\":%.9f,\"total\":%.9f,\"covers\":%zu,\"coverSize\":%zu}\n",
+			run->optimise, run->total, run->n_covers, run->coverSize);
+		return;
+	}
+
+	McCluskeyBench_csvRow(out, spec, table, n_threads, repeat, "ingest", 0, run->ingest, table->n_rows);
+	McCluskeyBench_csvRow(out, spec, table, n_threads, repeat, "sort", 0, run->sort, table->n_rows);
+	McCluskeyBench_csvRow(out, spec, table, n_threads, repeat, "setup", 0, run->setup, table->n_rows);
+	for (size_t i = 0; i < run->n_layers; ++i)
+	{
+		McCluskeyBench_csvRow(out, spec, table, n_threads, repeat, "solveLayer", i + 1, run->layers[i], run->layerNodes[i]);
+	}
+	McCluskeyBench_csvRow(out, spec, table, n_threads, repeat, "optimiseLayer", 0, run->optimise, run->n_covers);
+	McCluskeyBench_csvRow(out, spec, table, n_threads, repeat, "total", 0, run->total, run->coverSize);
+}
+
+static void McCluskeyBench_usage(const char * name)
+{
+	fprintf(stderr,
+		"Usage: %s [--case SPEC]... [--threads N,N,...] [--repeat N] [--seed N]\n"
+		"\t[--format csv|json] [--output FILE] [--lookup] [--espresso] [--low-memory] [--list]\n"
+		"\t[--generate SPEC]\n"
+		"SPEC: FAMILY:VARIABLES[:DENSITY[:DONTCARES[:OUTPUTS]]], FAMILY being random,\n"
+		"\tdontcare, parity, majority, adder, comparator or cyclic\n", name);
+}
+
+int main(int argc, char ** argv)
+{
+	const char ** cases = calloc((size_t)argc + MCCLUSKEYBENCH_SUITE, sizeof(const char *));
+	size_t n_cases = 0;
+	size_t threads[64] = { 1 }, n_threads = 1;
+	size_t repeats = 1;
+	uint64_t seed = 1;
+	bool json = false, lookup = false, espresso = false, lowMemory = false;
+	const char * outPath = NULL, * generate = NULL;
+	if (cases == NULL)
+	{
+		return 1;
+	}
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = (i + 1) < argc;
+		if (strcmp(argv[i], "--case") == 0 && hasValue)
+		{
+			cases[n_cases++] = argv[++i];
+		}
+		else if (strcmp(argv[i], "--threads") == 0 && hasValue)
+		{
+			// Thread sweep, 0 uses all hardware threads
+			n_threads = 0;
+			for (char * str = argv[++i], * end; *str != '\0' && n_threads < 64; str = end + (*end == ','))
+			{
+				threads[n_threads++] = (size_t)strtoull(str, &end, 10);
+				if (end == str || *str == '-' || threads[n_threads - 1] > MCPOOL_MAX_THREADS)
+				{
+					n_threads = 0;
+					break;
+				}
+			}
+			if (n_threads == 0)
+			{
+				McCluskeyBench_usage(argv[0]);
+				free(cases);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--repeat") == 0 && hasValue)
+		{
+			char * end;
+			++i;
+			repeats = (size_t)strtoull(argv[i], &end, 10);
+			if (*end != '\0' || end == argv[i] || argv[i][0] == '-' || repeats == 0)
+			{
+				McCluskeyBench_usage(argv[0]);
+				free(cases);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+		{
+			char * end;
+			++i;
+			seed = (uint64_t)strtoull(argv[i], &end, 10);
+			if (*end != '\0' || end == argv[i] || argv[i][0] == '-')
+			{
+				McCluskeyBench_usage(argv[0]);
+				free(cases);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--format") == 0 && hasValue)
+		{
+			++i;
+			json = strcmp(argv[i], "json") == 0;
+			if (json == false && strcmp(argv[i], "csv") != 0)
+			{
+				McCluskeyBench_usage(argv[0]);
+				free(cases);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--output") == 0 && hasValue)
+		{
+			outPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--generate") == 0 && hasValue)
+		{
+			generate = argv[++i];
+		}
+		else if (strcmp(argv[i], "--lookup") == 0)
+		{
+			lookup = true;
+		}
+		else if (strcmp(argv[i], "--espresso") == 0)
+		{
+			espresso = true;
+		}
+		else if (strcmp(argv[i], "--low-memory") == 0)
+		{
+			lowMemory = true;
+		}
+		else if (strcmp(argv[i], "--list") == 0)
+		{
+			for (size_t j = 0; j < MCCLUSKEYBENCH_SUITE; ++j)
+			{
+				printf("%s\n", McCluskeyBench_suite[j]);
+			}
+			free(cases);
+			return 0;
+		}
+		else
+		{
+			McCluskeyBench_usage(argv[0]);
+			free(cases);
+			return 1;
+		}
+	}
+
+	McCluskeyBenchTable_t table;
+	if (generate != NULL)
+	{
+		// Writes the table in the input format of the solver
+		const bool generated = McCluskeyBench_generate(&table, generate, seed);
+		if (generated)
+		{
+			fwrite(table.text, 1, table.len, stdout);
+		}
+		else
+		{
+			fprintf(stderr, "Invalid case \"%s\"\n", generate);
+		}
+		McCluskeyBench_freeTable(&table);
+		free(cases);
+		return generated ? 0 : 1;
+	}
+	if (n_cases == 0)
+	{
+		memcpy(cases, McCluskeyBench_suite, sizeof McCluskeyBench_suite);
+		n_cases = MCCLUSKEYBENCH_SUITE;
+	}
+
+	FILE * out = (outPath != NULL) ? fopen(outPath, "w") : stdout;
+	if (out == NULL)
+	{
+		fprintf(stderr, "Cannot open \"%s\"\n", outPath);
+		free(cases);
+		return 1;
+	}
+	fprintf(stderr, "Scan kernel: %s\n", McCluskeyScan_getKernelName());
+	if (json == false)
+	{
+		fprintf(out, "case,variables,outputs,rows,threads,repeat,phase,layer,seconds,nodes\n");
+	}
+
+	int status = 0;
+	McCluskeyBenchRun_t run = { 0 };
+	for (size_t c = 0; c < n_cases; ++c)
+	{
+		if (McCluskeyBench_generate(&table, cases[c], seed) == false)
+		{
+			fprintf(stderr, "Invalid case \"%s\"\n", cases[c]);
+			McCluskeyBench_freeTable(&table);
+			status = 1;
+			continue;
+		}
+		for (size_t t = 0; t < n_threads; ++t)
+		{
+			McCluskeyCtx_t ctx;
+			McCluskeyCtx_make(&ctx);
+			McCluskeyCtx_setThreads(&ctx, threads[t]);
+			McCluskeyCtx_setPrimeMode(&ctx, lookup ? McCluskeyPrimeMode_lookup : McCluskeyPrimeMode_pairScan);
+			McCluskeyCtx_setEngine(&ctx, espresso ? McCluskeyEngine_espresso : McCluskeyEngine_exact);
+			McCluskeyCtx_setLowMemory(&ctx, lowMemory);
+			for (size_t r = 0; r < repeats; ++r)
+			{
+				if (McCluskeyBench_run(&table, &ctx, &run) == false)
+				{
+					fprintf(stderr, "Case \"%s\" failed\n", cases[c]);
+					status = 1;
+					break;
+				}
+				McCluskeyBench_write(out, json, cases[c], &table, threads[t], r + 1, &run);
+				fflush(out);
+			}
+		}
+		McCluskeyBench_freeTable(&table);
+	}
+
+	free(run.layers);
+	free(run.layerNodes);
+	free(cases);
+	if (out != stdout && fclose(out) != 0)
+	{
+		status = 1;
+	}
+	return status;
+}
@@ -1,4 +1,8 @@
 #include "mccluskey.h"
+#include "mccache.h"
+#include "mcinput.h"
+#include "mcoutput.h"
+#include "mcpool.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -6,160 +10,610 @@
 
 #define MAX_RIDA 256
 
-void showTruthTable(const McCluskeyVals_t * layer);
+///
+///	@brief Reads 1 line of any length from standard input
+///	@param line Pointer to line buffer, grown as needed
+///	@param cap Pointer to capacity of line buffer
+///	@param len Pointer to variable receiving the length of the line without line break
+///	@returns Whether a line was read, false at the end of input
+///
+bool readLine(char ** line, size_t * cap, size_t * len);
+///
+///	@brief Reads 1 truth table until an empty line or the end of input
+///	@param ctx Context receiving the value mode
+///	@param sourcemap Empty array receiving the nodes
+///	@param line Pointer to line buffer
+///	@param cap Pointer to capacity of line buffer
+///	@param out Output writer for messages
+///	@returns Whether the end of input was reached
+///
+bool readTable(McCluskeyCtx_t * ctx, McCluskeyVals_t * sourcemap, char ** line, size_t * cap, McCluskeyOutput_t * out);
+///
+///	@brief Solves 1 truth table and prints the results, exits on failure
+///	@param ctx Context holding the mode and solver options
+///	@param solver Solver object, created on first use and reset afterwards
+///	@param hasSolver Whether the solver object has been created
+///	@param sourcemap Nodes of the truth table, receives memory for the next table
+///	@param sortScratch Scratch array for sorting
+///	@param sorted Whether the nodes are already sorted by the number of ones
+///	@param cache Cache of results, NULL if not used
+///	@param out Output writer
+///	@param number Number of the table, counting from 1
+///
+void solveTable(
+	const McCluskeyCtx_t * ctx,
+	McCluskeySolver_t * solver,
+	bool * hasSolver,
+	McCluskeyVals_t * sourcemap,
+	McCluskeyVals_t * sortScratch,
+	bool sorted,
+	McCluskeyCache_t * cache,
+	McCluskeyOutput_t * out,
+	size_t number
+);
+///
+///	@brief Prints the prime implicants and covers of a solver holding results
+///	@param ctx Context holding the solver options
+///	@param solver Solver object
+///	@param newLayers Number of cover layers
+///	@param out Output writer
+///	@param number Number of the table, counting from 1
+///
+void writeResults(
+	const McCluskeyCtx_t * ctx,
+	McCluskeySolver_t * solver,
+	size_t newLayers,
+	McCluskeyOutput_t * out,
+	size_t number
+);
+///
+///	@brief Prints the statistics of a solver if enabled by --stats
+///	@param solver Solver object
+///	@param out Output writer
+///
+void writeStats(const McCluskeySolver_t * solver, McCluskeyOutput_t * out);
+///
+///	@brief Reads edits of a solved truth table until an empty line: "+[row]" adds and
+///	"-[row]" removes the outputs of a row given as '1' or '-'. The table is then
+///	updated incrementally and the results are printed, until an empty line without
+///	edits or the end of input. Exits on failure
+///	@param ctx Context holding the value mode of the table
+///	@param solver Solver object holding the solved table
+///	@param line Pointer to line buffer
+///	@param cap Pointer to capacity of line buffer
+///	@param out Output writer
+///	@param number Number of the table, counting from 1
+///
+void editTable(
+	McCluskeyCtx_t * ctx,
+	McCluskeySolver_t * solver,
+	char ** line,
+	size_t * cap,
+	McCluskeyOutput_t * out,
+	size_t number
+);
 
-int main()
+int main(int argc, char ** argv)
 {
-	McCluskeyVals_t sourcemap;
-	McCluskeyVals_make(&sourcemap);
+	McCluskeyCtx_t ctx;
+	McCluskeyCtx_make(&ctx);
+	bool batch = false, edit = false;
+	const char * path = NULL, * cachePath = NULL;
+	McCluskeyFormat_t format = McCluskeyFormat_text;
+	bool parents = true, stats = false;
+	double timeBudget = 0.0;
+	uint64_t nodeBudget = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--lookup") == 0)
+		{
+			McCluskeyCtx_setPrimeMode(&ctx, McCluskeyPrimeMode_lookup);
+		}
+		else if (strcmp(argv[i], "--espresso") == 0)
+		{
+			McCluskeyCtx_setEngine(&ctx, McCluskeyEngine_espresso);
+		}
+		else if (strcmp(argv[i], "--batch") == 0)
+		{
+			batch = true;
+		}
+		else if (strcmp(argv[i], "--edit") == 0)
+		{
+			edit = true;
+		}
+		else if (strcmp(argv[i], "--file") == 0 && (i + 1) < argc)
+		{
+			++i;
+			path = argv[i];
+		}
+		else if (strcmp(argv[i], "--cache") == 0 && (i + 1) < argc)
+		{
+			++i;
+			cachePath = argv[i];
+		}
+		else if (strcmp(argv[i], "--no-parents") == 0)
+		{
+			parents = false;
+		}
+		else if (strcmp(argv[i], "--stats") == 0)
+		{
+#ifdef MCCLUSKEY_NO_STATS
+			printf("Statistika on kompileerimisel eemaldatud (MCCLUSKEY_NO_STATS)!\n");
+			return 1;
+#else
+			stats = true;
+#endif
+		}
+		else if (strcmp(argv[i], "--low-memory") == 0)
+		{
+			McCluskeyCtx_setLowMemory(&ctx, true);
+		}
+		else if (strcmp(argv[i], "--format") == 0 && (i + 1) < argc)
+		{
+			++i;
+			if (strcmp(argv[i], "text") == 0)
+			{
+				format = McCluskeyFormat_text;
+			}
+			else if (strcmp(argv[i], "json") == 0)
+			{
+				format = McCluskeyFormat_json;
+			}
+			else if (strcmp(argv[i], "binary") == 0)
+			{
+				format = McCluskeyFormat_binary;
+			}
+			else
+			{
+				printf("Tundmatu v2ljundi vorming \"%s\"!\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--threads") == 0 && (i + 1) < argc)
+		{
+			++i;
+			char * end;
+			const size_t n_threads = (size_t)strtoull(argv[i], &end, 10);
+			if (*end != '\0' || end == argv[i] || argv[i][0] == '-' || n_threads > MCPOOL_MAX_THREADS)
+			{
+				printf("Vigane l6imede arv \"%s\"!\n", argv[i]);
+				return 1;
+			}
+			McCluskeyCtx_setThreads(&ctx, n_threads);
+		}
+		else if (strcmp(argv[i], "--time-limit") == 0 && (i + 1) < argc)
+		{
+			++i;
+			char * end;
+			timeBudget = strtod(argv[i], &end);
+			if (*end != '\0' || end == argv[i] || !(timeBudget >= 0.0))
+			{
+				printf("Vigane ajapiirang \"%s\"!\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--node-limit") == 0 && (i + 1) < argc)
+		{
+			++i;
+			char * end;
+			nodeBudget = (uint64_t)strtoull(argv[i], &end, 10);
+			if (*end != '\0' || end == argv[i] || argv[i][0] == '-')
+			{
+				printf("Vigane s6lmede piirang \"%s\"!\n", argv[i]);
+				return 1;
+			}
+		}
+		else
+		{
+			printf("Tundmatu argument \"%s\"!\n", argv[i]);
+			printf("Kasutus: %s [--lookup] [--espresso] [--threads N] [--batch] [--file FAIL]\n"
+				"\t[--format text|json|binary] [--no-parents] [--edit] [--cache FAIL] [--stats]\n"
+				"\t[--low-memory] [--time-limit SEKUNDID] [--node-limit N]\n", argv[0]);
+			return 1;
+		}
+	}
+	McCluskeyCtx_setBudget(&ctx, timeBudget, nodeBudget);
+	if (batch && path != NULL)
+	{
+		printf("V6tmeid --batch ja --file ei saa koos kasutada!\n");
+		return 1;
+	}
+	else if (batch && edit)
+	{
+		printf("V6tmeid --batch ja --edit ei saa koos kasutada!\n");
+		return 1;
+	}
 
-	printf("Sisesta t6ev22rtustabel kujul [argumentvektor] [v22rtus]:\n");
-	
+	McCluskeyOutput_t out;
+	if (McCluskeyOutput_make(&out, stdout, format, parents, stats) == false)
+	{
+		printf("Ootamatu viga! V2ljundi puhvri loomine ei 6nnestunud! V2ljun...\n");
+		return 1;
+	}
+	McCluskeyCache_t cache;
+	if (cachePath != NULL && McCluskeyCache_open(&cache, cachePath) == false)
+	{
+		McCluskeyOutput_error(&out, "Vahem2lu faili \"%s\" ei saa avada!\n", cachePath);
+		McCluskeyOutput_destroy(&out);
+		return 1;
+	}
+	McCluskeyCache_t * usedCache = (cachePath != NULL) ? &cache : NULL;
 
-	uint8_t firstIter = 0;
+	McCluskeyVals_t sourcemap, sortScratch;
+	McCluskeyVals_make(&sourcemap, &ctx);
+	McCluskeyVals_make(&sortScratch, &ctx);
+	McCluskeySolver_t solver;
+	bool hasSolver = false;
+	char * line = NULL;
+	size_t lineCap = 0;
 
-	do
+	if (path != NULL)
 	{
-		if (firstIter < 2)
+		// Whole file is mapped to memory and parsed as 1 table
+		McCluskeyInputMap_t map;
+		if (McCluskeyInputMap_open(&map, path) == false)
+		{
+			McCluskeyOutput_error(&out, "Faili \"%s\" ei saa avada!\n", path);
+			McCluskeyVals_destroy(&sourcemap);
+			McCluskeyVals_destroy(&sortScratch);
+			if (usedCache != NULL)
+			{
+				McCluskeyCache_close(usedCache);
+			}
+			McCluskeyOutput_destroy(&out);
+			return 1;
+		}
+		size_t n_invalid;
+		bool sorted;
+		const bool success = McCluskeyInput_parseBuffer(&ctx, map.data, map.size, ctx.n_threads, &sourcemap, &n_invalid, &sorted);
+		McCluskeyInputMap_close(&map);
+		if (success == false)
+		{
+			McCluskeyOutput_error(&out, "Ootamatu viga! Ei saa rohkem andmeid sisestada! V2ljun...\n");
+			exit(1);
+		}
+		else if (n_invalid > 0)
+		{
+			McCluskeyOutput_message(&out, "Vigaseid ridu vahele j2etud: %zu\n", n_invalid);
+		}
+
+		solveTable(&ctx, &solver, &hasSolver, &sourcemap, &sortScratch, sorted, usedCache, &out, 1);
+		if (edit)
 		{
-			++firstIter;
+			editTable(&ctx, &solver, &line, &lineCap, &out, 1);
 		}
+	}
+	else
+	{
+		McCluskeyOutput_message(&out, "Sisesta t6ev22rtustabel kujul [argumentvektor] [v22rtus]:\n");
+		McCluskeyOutput_flush(&out);
 
-		char rida[MAX_RIDA];
-		// loe rida
-		fgets(rida, MAX_RIDA, stdin);
+		// Batch mode solves tables separated by empty lines until the end of input,
+		// memory of the solver is reused
+		size_t n_tables = 0;
+		bool eof = false;
+		while (eof == false)
 		{
-			char * end = strrchr(rida, '\n');
-			if (end != NULL)
+			eof = readTable(&ctx, &sourcemap, &line, &lineCap, &out);
+			if (batch)
+			{
+				if (sourcemap.n_vals == 0)
+				{
+					continue;
+				}
+				McCluskeyOutput_message(&out, "Ylesanne #%zu:\n", n_tables + 1);
+			}
+
+			solveTable(&ctx, &solver, &hasSolver, &sourcemap, &sortScratch, false, usedCache, &out, n_tables + 1);
+			++n_tables;
+			if (edit && eof == false)
 			{
-				*end = '\0';
+				editTable(&ctx, &solver, &line, &lineCap, &out, n_tables);
+			}
+
+			if (batch == false)
+			{
+				break;
 			}
 		}
+	}
+
+	if (hasSolver)
+	{
+		McCluskeySolver_destroy(&solver);
+	}
+	McCluskeyVals_destroy(&sourcemap);
+	McCluskeyVals_destroy(&sortScratch);
+	free(line);
 
-		if (strlen(rida) == 0 || feof(stdin) != 0)
+	bool written = true;
+	if (usedCache != NULL)
+	{
+		McCluskeyOutput_message(&out, "Vahem2lust leitud tabeleid: %zu/%zu\n", cache.n_hits, cache.n_hits + cache.n_misses);
+		if (McCluskeyCache_close(usedCache) == false)
 		{
-			break;
+			McCluskeyOutput_error(&out, "Vahem2lu faili \"%s\" kirjutamine ei 6nnestunud!\n", cachePath);
+			written = false;
 		}
+	}
 
-		char * argvec    = strtok(rida, " "),
-		     * valueStr  = strtok(NULL, " ");
+	McCluskeyOutput_message(&out, "M2lu puhastatud!\n");
+	written = McCluskeyOutput_flush(&out) && written;
+	McCluskeyOutput_destroy(&out);
 
-		McCluskeyVal_t value;
+	return written ? 0 : 1;
+}
 
-		if (argvec == NULL || valueStr == NULL || strlen(valueStr) != 1)
-		{
-			printf("Sisesta korrektne rida!\n");
-			continue;
-		}
-		else if (strncmp(argvec, "mode", 4) == 0)
+bool readLine(char ** line, size_t * cap, size_t * len)
+{
+	*len = 0;
+	do
+	{
+		if ((*cap - *len) < MAX_RIDA)
 		{
-			if (firstIter == 1)
+			const size_t newcap = (*cap == 0) ? MAX_RIDA : (*cap * 2);
+			char * mem = realloc(*line, newcap);
+			if (mem == NULL)
 			{
-				McCluskeyVal_setMode(valueStr[0]);
+				printf("Ootamatu viga! Ei saa rohkem andmeid sisestada! V2ljun...\n");
+				exit(1);
 			}
-			else
-			{
-				printf("Sisesta korrektne rida!\n");
-			}
-			continue;
+			*line = mem;
+			*cap  = newcap;
+		}
+		// Read in pieces so that interactive input is handled line by line
+		if (fgets(&(*line)[*len], (int)(*cap - *len), stdin) == NULL)
+		{
+			break;
 		}
-		else if (McCluskeyVal_make(&value, argvec, valueStr[0]) == false)
+		*len += strlen(&(*line)[*len]);
+	} while ((*line)[*len - 1] != '\n');
+
+	if (*len == 0)
+	{
+		return false;
+	}
+	while (*len > 0 && ((*line)[*len - 1] == '\n' || (*line)[*len - 1] == '\r'))
+	{
+		--(*len);
+	}
+	return true;
+}
+bool readTable(McCluskeyCtx_t * ctx, McCluskeyVals_t * sourcemap, char ** line, size_t * cap, McCluskeyOutput_t * out)
+{
+	McCluskeyInput_t input;
+	McCluskeyInput_make(&input, ctx);
+
+	size_t len;
+	while (readLine(line, cap, &len))
+	{
+		if (len == 0)
 		{
-			printf("Sisesta korrektne rida!\n");
-			continue;
+			return false;
 		}
 
-		if (McCluskeyVals_push(&sourcemap, &value) == false)
+		bool valid;
+		if (McCluskeyInput_parseLine(&input, *line, len, sourcemap, &valid) == false)
 		{
-			printf("Ootamatu viga! Ei saa rohkem andmeid sisestada! V2ljun...\n");
+			McCluskeyOutput_error(out, "Ootamatu viga! Ei saa rohkem andmeid sisestada! V2ljun...\n");
 			exit(1);
 		}
-	} while (1);
+		else if (valid == false)
+		{
+			McCluskeyOutput_message(out, "Sisesta korrektne rida!\n");
+			McCluskeyOutput_flush(out);
+		}
+	}
 
-	printf("L2hteandmed sisse loetud!\n");
+	return true;
+}
 
-	McCluskeyVals_sort(&sourcemap);
+void solveTable(
+	const McCluskeyCtx_t * ctx,
+	McCluskeySolver_t * solver,
+	bool * hasSolver,
+	McCluskeyVals_t * sourcemap,
+	McCluskeyVals_t * sortScratch,
+	bool sorted,
+	McCluskeyCache_t * cache,
+	McCluskeyOutput_t * out,
+	size_t number
+)
+{
+	McCluskeyOutput_message(out, "L2hteandmed sisse loetud!\n");
 
-	printf("L2hteandmed on sorteeritud!\n");
+	if (sorted == false && McCluskeyVals_sortWith(sourcemap, sortScratch) == false)
+	{
+		McCluskeyOutput_error(out, "Ootamatu viga! Ei suutnud andmeid sorteerida! V2ljun...\n");
+		exit(1);
+	}
 
-	McCluskeySolver_t solver;
+	McCluskeyOutput_message(out, "L2hteandmed on sorteeritud!\n");
 
-	if (McCluskeySolver_make(&solver, &sourcemap) == false)
+	if (*hasSolver)
 	{
-		printf("Ei suutnud lahendaja objekti teha! V2ljun...\n");
+		if (McCluskeySolver_reset(solver, sourcemap) == false)
+		{
+			McCluskeyOutput_error(out, "Ei suutnud lahendaja objekti teha! V2ljun...\n");
+			exit(1);
+		}
+	}
+	else
+	{
+		if (McCluskeySolver_make(solver, ctx, sourcemap) == false)
+		{
+			McCluskeyOutput_error(out, "Ei suutnud lahendaja objekti teha! V2ljun...\n");
+			exit(1);
+		}
+		*hasSolver = true;
+	}
+
+	size_t newLayers;
+	bool cached = false;
+	if (cache != NULL && McCluskeyCache_lookup(cache, solver, &cached, &newLayers) == false)
+	{
+		McCluskeyOutput_error(out, "Ootamatu viga! Vahem2lu lugemine ei 6nnestunud! V2ljun...\n");
 		exit(1);
 	}
+	else if (cached)
+	{
+		McCluskeyOutput_message(out, "Tulemus leitud vahem2lust!\n");
+		writeResults(ctx, solver, newLayers, out, number);
+		return;
+	}
 
 	// Lahendamine
 
-	while (McCluskeySolver_solveLayer(&solver) == true);
+	for (bool more = true; more;)
+	{
+		if (McCluskeySolver_solveLayer(solver, &more) == false)
+		{
+			McCluskeyOutput_error(out, "Tabeli lahendamine ei 6nnestunud!\n");
+			exit(1);
+		}
+	}
 
-	McCluskeyVals_t * layer = McCluskeySolver_getLayer(&solver);
+	McCluskeyVals_t * layer = McCluskeySolver_getLayer(solver);
 
 	if (layer == NULL)
 	{
-		printf("Illegaalsed andmed!\n");
+		McCluskeyOutput_error(out, "Illegaalsed andmed!\n");
 		exit(1);
 	}
 
-	printf("Esialgne \"lahendatud\" intervallide tabel:\n");
-	showTruthTable(layer);
+	const McCluskeyVals_t * baseLayer = McCluskeySolver_getBaseLayer(solver);
+	McCluskeyOutput_beginTable(out, number, baseLayer);
+	if (ctx->engine == McCluskeyEngine_exact)
+	{
+		McCluskeyOutput_message(out, "Esialgne \"lahendatud\" intervallide tabel:\n");
+		McCluskeyOutput_primes(out, layer, baseLayer);
+	}
+	else
+	{
+		McCluskeyOutput_primes(out, NULL, baseLayer);
+	}
 
-	size_t newLayers;
-	if (McCluskeySolver_optimiseLayer(&solver, &newLayers) == false)
+	if (McCluskeySolver_optimiseLayer(solver, &newLayers) == false)
 	{
-		printf("Tabeli optimeerimine ei 6nnestunud!\n");
+		McCluskeyOutput_error(out, "Tabeli optimeerimine ei 6nnestunud!\n");
 		exit(1);
 	}
-
-	printf("Tabel optimeeritud!\n");
-
-	printf("L6plik(ud) optimeeritud intervallide tabel(id):\n");
-	McCluskeyVals_t * optimalLayer = McCluskeySolver_getLayer(&solver) - (newLayers - 1);
-	for (size_t i = 0; i < newLayers; ++i)
+	else if (cache != NULL && McCluskeyCache_store(cache, solver, newLayers) == false)
 	{
-		printf("Tabel #%zu:\n", i + 1);
-		showTruthTable(optimalLayer);
-		++optimalLayer;
+		McCluskeyOutput_error(out, "Ootamatu viga! Vahem2llu salvestamine ei 6nnestunud! V2ljun...\n");
+		exit(1);
 	}
 
-	McCluskeySolver_destroy(&solver);
-
-	printf("M2lu puhastatud!\n");
+	McCluskeyOutput_message(out, "Tabel optimeeritud!\n");
 
-	return 0;
+	McCluskeyOutput_message(out, "L6plik(ud) optimeeritud intervallide tabel(id):\n");
+	// Optimising can move the layers
+	const McCluskeyVals_t * optimalLayer = McCluskeySolver_getLayer(solver) - (newLayers - 1);
+	McCluskeyOutput_covers(out, optimalLayer, newLayers, McCluskeySolver_getBaseLayer(solver), McCluskeySolver_isExpired(solver));
+	writeStats(solver, out);
+	McCluskeyOutput_endTable(out);
 }
-
-void showTruthTable(const McCluskeyVals_t * layer)
+void editTable(
+	McCluskeyCtx_t * ctx,
+	McCluskeySolver_t * solver,
+	char ** line,
+	size_t * cap,
+	McCluskeyOutput_t * out,
+	size_t number
+)
 {
-	for (size_t i = 0; i < layer->n_vals; ++i)
+	McCluskeyVals_t rows;
+	McCluskeyVals_make(&rows, ctx);
+
+	bool eof = false;
+	while (eof == false)
 	{
-		char arg[MCCLUSKEYVAL_MAX_ARGVEC + 1], value;
-		McCluskeyVal_getVecStr(layer->vals[i], arg, MCCLUSKEYVAL_MAX_ARGVEC + 1);
-		value = McCluskeyVal_getStateCh(layer->vals[i]);
-		
-		printf("%*s | %c (", MCCLUSKEYVAL_MAX_ARGVEC, arg, value);
-		const McCluskeyVal_t * val = layer->vals[i];
-		for (size_t j = 0; j < val->n_fromVec; ++j)
+		McCluskeyOutput_message(out, "Sisesta muudatused kujul +[rida] v6i -[rida]:\n");
+		McCluskeyOutput_flush(out);
+
+		// Edited rows are read in the mode of the table
+		McCluskeyInput_t input;
+		McCluskeyInput_resume(&input, ctx, McCluskeySolver_getBaseLayer(solver));
+
+		bool edited = false;
+		size_t len;
+		while ((eof = (readLine(line, cap, &len) == false)) == false && len > 0)
 		{
-			if (val->fromVec[j]->state != McCluskeyState_one)
+			const char op = (*line)[0];
+			bool valid = false;
+			McCluskeyVals_clear(&rows);
+			if ((op == '+' || op == '-') &&
+				McCluskeyInput_parseLine(&input, *line + 1, len - 1, &rows, &valid) == false)
 			{
-				putchar('*');
+				McCluskeyOutput_error(out, "Ootamatu viga! Ei saa rohkem andmeid sisestada! V2ljun...\n");
+				exit(1);
 			}
-			else
+			for (size_t i = 0; valid && i < rows.n_vals; ++i)
 			{
-				McCluskeyVal_getVecStr(val->fromVec[j], arg, MCCLUSKEYVAL_MAX_ARGVEC + 1);
-				printf("%s", arg);
+				McCluskeyVal_t val;
+				McCluskeyVals_get(&rows, i, &val);
+				if ((op == '+') ? (McCluskeySolver_addRow(solver, &val) == false) :
+					(McCluskeySolver_removeRow(solver, &val) == false))
+				{
+					McCluskeyOutput_error(out, "Ootamatu viga! Ei saa rohkem andmeid sisestada! V2ljun...\n");
+					exit(1);
+				}
 			}
-			if (j < val->n_fromVec - 1)
+			if (valid == false)
 			{
-				putchar(',');
+				McCluskeyOutput_message(out, "Sisesta korrektne muudatus!\n");
+				McCluskeyOutput_flush(out);
 			}
+			edited |= valid;
+		}
+		if (edited == false)
+		{
+			break;
 		}
-		if (val->n_fromVec == 0)
+
+		size_t newLayers;
+		if (McCluskeySolver_update(solver, &newLayers) == false)
 		{
-			putchar('*');
+			McCluskeyOutput_error(out, "Tabeli uuendamine ei 6nnestunud!\n");
+			exit(1);
 		}
-		printf(")\n");
+		McCluskeyOutput_message(out, "Tabel uuendatud!\n");
+		writeResults(ctx, solver, newLayers, out, number);
+	}
+
+	McCluskeyVals_destroy(&rows);
+}
+void writeResults(
+	const McCluskeyCtx_t * ctx,
+	McCluskeySolver_t * solver,
+	size_t newLayers,
+	McCluskeyOutput_t * out,
+	size_t number
+)
+{
+	const McCluskeyVals_t * coverLayer = McCluskeySolver_getLayer(solver) - (newLayers - 1);
+	const McCluskeyVals_t * baseLayer = McCluskeySolver_getBaseLayer(solver);
+	McCluskeyOutput_beginTable(out, number, baseLayer);
+	if (ctx->engine == McCluskeyEngine_exact)
+	{
+		McCluskeyOutput_message(out, "Esialgne \"lahendatud\" intervallide tabel:\n");
+		McCluskeyOutput_primes(out, coverLayer - 1, baseLayer);
+	}
+	else
+	{
+		McCluskeyOutput_primes(out, NULL, baseLayer);
+	}
+	McCluskeyOutput_message(out, "L6plik(ud) optimeeritud intervallide tabel(id):\n");
+	McCluskeyOutput_covers(out, coverLayer, newLayers, baseLayer, McCluskeySolver_isExpired(solver));
+	writeStats(solver, out);
+	McCluskeyOutput_endTable(out);
+}
+void writeStats(const McCluskeySolver_t * solver, McCluskeyOutput_t * out)
+{
+	if (out->stats)
+	{
+		McCluskeyStats_t stats;
+		McCluskeySolver_getStats(solver, &stats);
+		McCluskeyOutput_stats(out, &stats);
 	}
 }
@@ -0,0 +1,711 @@
+#include "mccache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MCCLUSKEYCACHE_VERSION 1
+
+#define MCCLUSKEYCACHE_FILE_HEADER 8
+#define MCCLUSKEYCACHE_ENTRY_HEADER 36
+#define MCCLUSKEYCACHE_NODE (2 * sizeof(McCluskeyMask_t) + 2 * sizeof(uint32_t))
+
+///
+///	@brief Header fields of 1 cache entry
+///
+typedef struct McCluskeyCacheEntry
+{
+	uint64_t hash, size;
+	McCluskeyEngine_t engine;
+	uint8_t n_vars, n_outputs;
+	uint32_t n_rows, n_primes, n_covers, coverSize;
+
+	const uint8_t * rows, * primes, * covers;
+
+} McCluskeyCacheEntry_t;
+
+static inline uint64_t McCluskeyCache_mix(uint64_t hash, uint64_t value)
+{
+	hash ^= value + UINT64_C(0x9e3779b97f4a7c15) + (hash << 6) + (hash >> 2);
+	hash ^= hash >> 30;
+	hash *= UINT64_C(0xbf58476d1ce4e5b9);
+	hash ^= hash >> 27;
+	hash *= UINT64_C(0x94d049bb133111eb);
+	hash ^= hash >> 31;
+	return hash;
+}
+static inline uint64_t McCluskeyCache_mixMask(uint64_t hash, McCluskeyMask_t mask)
+{
+#if MCCLUSKEY_WIDTH == 128
+	hash = McCluskeyCache_mix(hash, (uint64_t)(mask >> 64));
+#endif
+	return McCluskeyCache_mix(hash, (uint64_t)mask);
+}
+
+///
+///	@brief Ensures room for n more bytes in the buffer of new entries
+///	@returns Pointer to the end of the buffer, NULL on failure
+///
+static inline uint8_t * McCluskeyCache_reserve(McCluskeyCache_t * restrict This, size_t n)
+{
+	if ((This->n_buf + n) > This->cap_buf)
+	{
+		size_t newcap = (This->n_buf + n) * 2;
+		uint8_t * mem = realloc(This->buf, newcap);
+		if (mem == NULL)
+		{
+			return NULL;
+		}
+		This->buf     = mem;
+		This->cap_buf = newcap;
+	}
+	return &This->buf[This->n_buf];
+}
+static inline uint8_t * McCluskeyCache_put(uint8_t * restrict dst, const void * restrict src, size_t n)
+{
+	memcpy(dst, src, n);
+	return dst + n;
+}
+static inline uint8_t * McCluskeyCache_putNode(
+	uint8_t * restrict dst,
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes,
+	McCluskeyTag_t onTag,
+	McCluskeyTag_t dcTag
+)
+{
+	const uint32_t on = onTag, dc = dcTag;
+	dst = McCluskeyCache_put(dst, &ones,   sizeof(McCluskeyMask_t));
+	dst = McCluskeyCache_put(dst, &dashes, sizeof(McCluskeyMask_t));
+	dst = McCluskeyCache_put(dst, &on,     sizeof(uint32_t));
+	return McCluskeyCache_put(dst, &dc,    sizeof(uint32_t));
+}
+///
+///	@brief Reads node i of an array of nodes in file format, the data may be unaligned
+///
+static inline McCluskeyCacheRow_t McCluskeyCache_getNode(const uint8_t * restrict nodes, size_t i)
+{
+	McCluskeyCacheRow_t row;
+	uint32_t on, dc;
+	const uint8_t * src = &nodes[i * MCCLUSKEYCACHE_NODE];
+	memcpy(&row.ones,   src, sizeof(McCluskeyMask_t));
+	memcpy(&row.dashes, src + sizeof(McCluskeyMask_t), sizeof(McCluskeyMask_t));
+	memcpy(&on, src + 2 * sizeof(McCluskeyMask_t), sizeof(uint32_t));
+	memcpy(&dc, src + 2 * sizeof(McCluskeyMask_t) + sizeof(uint32_t), sizeof(uint32_t));
+	row.onTag = on;
+	row.dcTag = dc;
+	return row;
+}
+///
+///	@brief Reads the header of an entry of at most avail bytes
+///	@returns Whether the entry is complete and its sizes are consistent
+///
+static inline bool McCluskeyCache_readEntry(const uint8_t * restrict data, size_t avail, McCluskeyCacheEntry_t * restrict entry)
+{
+	if (avail < MCCLUSKEYCACHE_ENTRY_HEADER)
+	{
+		return false;
+	}
+	memcpy(&entry->hash, data, sizeof(uint64_t));
+	memcpy(&entry->size, data + 8, sizeof(uint64_t));
+	entry->engine    = data[16];
+	entry->n_vars    = data[17];
+	entry->n_outputs = data[18];
+	memcpy(&entry->n_rows,    data + 20, sizeof(uint32_t));
+	memcpy(&entry->n_primes,  data + 24, sizeof(uint32_t));
+	memcpy(&entry->n_covers,  data + 28, sizeof(uint32_t));
+	memcpy(&entry->coverSize, data + 32, sizeof(uint32_t));
+
+	const uint64_t size = MCCLUSKEYCACHE_ENTRY_HEADER +
+		((uint64_t)entry->n_rows + entry->n_primes) * MCCLUSKEYCACHE_NODE +
+		(uint64_t)entry->n_covers * entry->coverSize * sizeof(uint32_t);
+	if (entry->size != size || size > avail || entry->n_vars > MCCLUSKEYVAL_MAX_ARGVEC)
+	{
+		return false;
+	}
+	entry->rows   = data + MCCLUSKEYCACHE_ENTRY_HEADER;
+	entry->primes = entry->rows + (size_t)entry->n_rows * MCCLUSKEYCACHE_NODE;
+	entry->covers = entry->primes + (size_t)entry->n_primes * MCCLUSKEYCACHE_NODE;
+	return true;
+}
+///
+///	@returns Pointer to the data of entry i
+///
+static inline const uint8_t * McCluskeyCache_getEntry(const McCluskeyCache_t * restrict This, size_t i)
+{
+	const size_t off = This->entries[i];
+	return (off < This->n_valid) ? (const uint8_t *)This->map.data + off : This->buf + (off - This->n_valid);
+}
+///
+///	@brief Adds an entry at given offset to the hash index
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyCache_addEntry(McCluskeyCache_t * restrict This, size_t off, uint64_t hash)
+{
+	if (This->n_entries >= This->cap_entries)
+	{
+		size_t newcap = (This->n_entries + 1) * 2;
+		size_t * mem = realloc(This->entries, sizeof(size_t) * newcap);
+		if (mem == NULL)
+		{
+			return false;
+		}
+		This->entries     = mem;
+		This->cap_entries = newcap;
+	}
+	if ((This->n_entries + 1) * 2 > This->n_index)
+	{
+		size_t n_index = 16;
+		while (n_index < (This->n_entries + 1) * 4)
+		{
+			n_index *= 2;
+		}
+		uint32_t * index = calloc(n_index, sizeof(uint32_t));
+		if (index == NULL)
+		{
+			return false;
+		}
+		free(This->index);
+		This->index   = index;
+		This->n_index = n_index;
+		for (size_t i = 0; i < This->n_entries; ++i)
+		{
+			McCluskeyCacheEntry_t entry;
+			memcpy(&entry.hash, McCluskeyCache_getEntry(This, i), sizeof(uint64_t));
+			size_t slot = (size_t)entry.hash & (n_index - 1);
+			while (index[slot] != 0)
+			{
+				slot = (slot + 1) & (n_index - 1);
+			}
+			index[slot] = (uint32_t)(i + 1);
+		}
+	}
+
+	This->entries[This->n_entries] = off;
+	++This->n_entries;
+	size_t slot = (size_t)hash & (This->n_index - 1);
+	while (This->index[slot] != 0)
+	{
+		slot = (slot + 1) & (This->n_index - 1);
+	}
+	This->index[slot] = (uint32_t)This->n_entries;
+	return true;
+}
+
+bool McCluskeyCache_open(McCluskeyCache_t * restrict This, const char * restrict path)
+{
+	memset(This, 0, sizeof(McCluskeyCache_t));
+	This->path = malloc(strlen(path) + 1);
+	if (This->path == NULL)
+	{
+		return false;
+	}
+	strcpy(This->path, path);
+
+	// A missing file is created on closing
+	FILE * file = fopen(path, "rb");
+	if (file != NULL)
+	{
+		fclose(file);
+		if (McCluskeyInputMap_open(&This->map, path) == false)
+		{
+			McCluskeyCache_close(This);
+			return false;
+		}
+	}
+
+	const uint8_t * data = (const uint8_t *)This->map.data;
+	if (This->map.size == 0)
+	{
+		const uint8_t header[MCCLUSKEYCACHE_FILE_HEADER] = {
+			'M', 'C', 'C', 'C', MCCLUSKEYCACHE_VERSION, (uint8_t)sizeof(McCluskeyMask_t), 0, 0
+		};
+		uint8_t * dst = McCluskeyCache_reserve(This, sizeof header);
+		if (dst == NULL)
+		{
+			McCluskeyCache_close(This);
+			return false;
+		}
+		memcpy(dst, header, sizeof header);
+		This->n_buf = sizeof header;
+		return true;
+	}
+	else if (This->map.size < MCCLUSKEYCACHE_FILE_HEADER || memcmp(data, "MCCC", 4) != 0 ||
+		data[4] != MCCLUSKEYCACHE_VERSION || data[5] != sizeof(McCluskeyMask_t)
+	)
+	{
+		McCluskeyCache_close(This);
+		return false;
+	}
+
+	size_t off = MCCLUSKEYCACHE_FILE_HEADER;
+	McCluskeyCacheEntry_t entry;
+	while (McCluskeyCache_readEntry(&data[off], This->map.size - off, &entry))
+	{
+		This->n_valid = off + (size_t)entry.size;
+		if (McCluskeyCache_addEntry(This, off, entry.hash) == false)
+		{
+			McCluskeyCache_close(This);
+			return false;
+		}
+		off += (size_t)entry.size;
+	}
+	This->n_valid = off;
+	return true;
+}
+
+///
+///	@brief Moves bit i of a mask to bit perm[i]
+///
+static inline McCluskeyMask_t McCluskeyCache_permute(const uint8_t * restrict perm, McCluskeyMask_t mask)
+{
+	McCluskeyMask_t result = 0;
+	while (mask != 0)
+	{
+		result |= (McCluskeyMask_t)1 << perm[McCluskeyMask_ctz(mask)];
+		mask &= mask - 1;
+	}
+	return result;
+}
+static int McCluskeyCache_cmpRows(const void * lhs, const void * rhs)
+{
+	const McCluskeyCacheRow_t * a = lhs, * b = rhs;
+	if (a->dashes != b->dashes)
+	{
+		return (a->dashes < b->dashes) ? -1 : 1;
+	}
+	return (a->ones > b->ones) - (a->ones < b->ones);
+}
+///
+///	@brief Signature of 1 variable, invariant under negating and permuting other
+///	variables
+///
+typedef struct McCluskeyCacheSig
+{
+	// Number of rows and hashed output tags of rows having the variable as '0' / '1'
+	uint64_t n[2], tags[2];
+	uint64_t n_dashes;
+	uint8_t var;
+
+} McCluskeyCacheSig_t;
+
+static inline bool McCluskeyCache_sigBefore(const McCluskeyCacheSig_t * restrict a, const McCluskeyCacheSig_t * restrict b)
+{
+	if (a->n[1] != b->n[1])
+	{
+		return a->n[1] > b->n[1];
+	}
+	else if (a->tags[1] != b->tags[1])
+	{
+		return a->tags[1] > b->tags[1];
+	}
+	else if (a->n[0] != b->n[0])
+	{
+		return a->n[0] > b->n[0];
+	}
+	else if (a->tags[0] != b->tags[0])
+	{
+		return a->tags[0] > b->tags[0];
+	}
+	else if (a->n_dashes != b->n_dashes)
+	{
+		return a->n_dashes > b->n_dashes;
+	}
+	return a->var < b->var;
+}
+///
+///	@brief Computes the canonical form of the first layer of a solver. Each variable
+///	is negated if that puts more rows on its '0' side, the variables are then ordered
+///	by their signatures
+///	@param cacheable Pointer to variable receiving whether the table can be cached
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyCache_canonise(McCluskeyCache_t * restrict This, const McCluskeySolver_t * restrict solver, bool * restrict cacheable)
+{
+	const McCluskeyVals_t * base = &solver->set[0];
+	McCluskeyCacheCanon_t * canon = &This->canon;
+	*cacheable = false;
+	This->n_rows = 0;
+	if (base->n_vals == 0 || base->n_vals > UINT32_MAX)
+	{
+		return true;
+	}
+	canon->n_vars    = base->lens[0];
+	canon->n_outputs = base->n_outputs;
+	canon->engine    = solver->ctx->engine;
+	for (size_t i = 1; i < base->n_vals; ++i)
+	{
+		if (base->lens[i] != canon->n_vars)
+		{
+			return true;
+		}
+	}
+
+	McCluskeyCacheSig_t sigs[MCCLUSKEYVAL_MAX_ARGVEC];
+	memset(sigs, 0, sizeof sigs);
+	for (size_t i = 0; i < base->n_vals; ++i)
+	{
+		if ((base->onTags[i] | base->dcTags[i]) == 0)
+		{
+			continue;
+		}
+		const uint64_t tags = McCluskeyCache_mix(0, ((uint64_t)base->onTags[i] << 32) | base->dcTags[i]);
+		for (uint8_t j = 0; j < canon->n_vars; ++j)
+		{
+			const McCluskeyMask_t bit = (McCluskeyMask_t)1 << j;
+			if (base->dashes[i] & bit)
+			{
+				++sigs[j].n_dashes;
+			}
+			else
+			{
+				const size_t side = (base->ones[i] & bit) != 0;
+				++sigs[j].n[side];
+				sigs[j].tags[side] += tags;
+			}
+		}
+	}
+
+	canon->neg = 0;
+	for (uint8_t j = 0; j < canon->n_vars; ++j)
+	{
+		McCluskeyCacheSig_t * sig = &sigs[j];
+		sig->var = j;
+		if (sig->n[1] > sig->n[0] || (sig->n[1] == sig->n[0] && sig->tags[1] > sig->tags[0]))
+		{
+			canon->neg |= (McCluskeyMask_t)1 << j;
+			const uint64_t n = sig->n[0], tags = sig->tags[0];
+			sig->n[0]    = sig->n[1];
+			sig->tags[0] = sig->tags[1];
+			sig->n[1]    = n;
+			sig->tags[1] = tags;
+		}
+	}
+	// Insertion sort, there are only a few variables
+	for (uint8_t j = 1; j < canon->n_vars; ++j)
+	{
+		const McCluskeyCacheSig_t sig = sigs[j];
+		uint8_t k = j;
+		for (; k > 0 && McCluskeyCache_sigBefore(&sig, &sigs[k - 1]); --k)
+		{
+			sigs[k] = sigs[k - 1];
+		}
+		sigs[k] = sig;
+	}
+	for (uint8_t j = 0; j < canon->n_vars; ++j)
+	{
+		canon->perm[sigs[j].var] = j;
+	}
+
+	if (base->n_vals > This->cap_rows)
+	{
+		McCluskeyCacheRow_t * mem = realloc(This->rows, sizeof(McCluskeyCacheRow_t) * base->n_vals);
+		if (mem == NULL)
+		{
+			return false;
+		}
+		This->rows     = mem;
+		This->cap_rows = base->n_vals;
+	}
+	for (size_t i = 0; i < base->n_vals; ++i)
+	{
+		if ((base->onTags[i] | base->dcTags[i]) != 0)
+		{
+			This->rows[This->n_rows] = (McCluskeyCacheRow_t){
+				.ones   = McCluskeyCache_permute(canon->perm, base->ones[i] ^ (canon->neg & ~base->dashes[i])),
+				.dashes = McCluskeyCache_permute(canon->perm, base->dashes[i]),
+				.onTag  = base->onTags[i],
+				.dcTag  = base->dcTags[i]
+			};
+			++This->n_rows;
+		}
+	}
+	qsort(This->rows, This->n_rows, sizeof(McCluskeyCacheRow_t), &McCluskeyCache_cmpRows);
+
+	// Duplicate rows are merged like McCluskeyVals_removeDuplicates does
+	size_t n_rows = 0;
+	for (size_t i = 0; i < This->n_rows; ++i)
+	{
+		McCluskeyCacheRow_t * last = (n_rows > 0) ? &This->rows[n_rows - 1] : NULL;
+		if (last != NULL && last->ones == This->rows[i].ones && last->dashes == This->rows[i].dashes)
+		{
+			last->onTag |= This->rows[i].onTag;
+			last->dcTag  = (last->dcTag | This->rows[i].dcTag) & ~last->onTag;
+		}
+		else
+		{
+			This->rows[n_rows] = This->rows[i];
+			++n_rows;
+		}
+	}
+	This->n_rows = n_rows;
+	if (n_rows == 0)
+	{
+		return true;
+	}
+
+	uint64_t hash = McCluskeyCache_mix(0, ((uint64_t)canon->engine << 16) | ((uint64_t)canon->n_vars << 8) | canon->n_outputs);
+	for (size_t i = 0; i < n_rows; ++i)
+	{
+		hash = McCluskeyCache_mixMask(hash, This->rows[i].ones);
+		hash = McCluskeyCache_mixMask(hash, This->rows[i].dashes);
+		hash = McCluskeyCache_mix(hash, ((uint64_t)This->rows[i].onTag << 32) | This->rows[i].dcTag);
+	}
+	canon->hash = hash;
+	*cacheable = true;
+	return true;
+}
+///
+///	@returns Whether an entry holds the canonical table of the last lookup
+///
+static inline bool McCluskeyCache_matches(const McCluskeyCache_t * restrict This, const McCluskeyCacheEntry_t * restrict entry)
+{
+	if (entry->hash != This->canon.hash || entry->engine != This->canon.engine ||
+		entry->n_vars != This->canon.n_vars || entry->n_outputs != This->canon.n_outputs ||
+		entry->n_rows != This->n_rows
+	)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < This->n_rows; ++i)
+	{
+		const McCluskeyCacheRow_t row = McCluskeyCache_getNode(entry->rows, i);
+		if (row.ones != This->rows[i].ones || row.dashes != This->rows[i].dashes ||
+			row.onTag != This->rows[i].onTag || row.dcTag != This->rows[i].dcTag
+		)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+///
+///	@brief Loads the results of an entry to a solver, mapped back to the variables
+///	of the table
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyCache_load(
+	const McCluskeyCache_t * restrict This,
+	const McCluskeyCacheEntry_t * restrict entry,
+	McCluskeySolver_t * restrict solver
+)
+{
+	const McCluskeyCacheCanon_t * canon = &This->canon;
+	uint8_t inverse[MCCLUSKEYVAL_MAX_ARGVEC];
+	for (uint8_t j = 0; j < canon->n_vars; ++j)
+	{
+		inverse[canon->perm[j]] = j;
+	}
+
+	McCluskeyVal_t * primes = malloc(sizeof(McCluskeyVal_t) * (entry->n_primes + 1));
+	uint32_t * terms = malloc(sizeof(uint32_t) * (entry->coverSize + 1));
+	bool success = (primes != NULL) && (terms != NULL);
+	for (size_t i = 0; success && i < entry->n_primes; ++i)
+	{
+		const McCluskeyCacheRow_t node = McCluskeyCache_getNode(entry->primes, i);
+		const McCluskeyMask_t dashes = McCluskeyCache_permute(inverse, node.dashes);
+		const McCluskeyMask_t ones   = McCluskeyCache_permute(inverse, node.ones) ^ (canon->neg & ~dashes);
+		primes[i] = (McCluskeyVal_t){
+			.ones      = ones,
+			.dashes    = dashes,
+			.onTag     = node.onTag,
+			.dcTag     = node.dcTag,
+			.len       = canon->n_vars,
+			.numOnes   = McCluskeyMask_popcount(ones),
+			.n_outputs = canon->n_outputs,
+			.state     = (node.onTag != 0) ? McCluskeyState_one : McCluskeyState_undefined
+		};
+	}
+	success = success && McCluskeySolver_loadPrimes(solver, primes, entry->n_primes);
+	for (size_t i = 0; success && i < entry->n_covers; ++i)
+	{
+		memcpy(terms, &entry->covers[i * entry->coverSize * sizeof(uint32_t)], sizeof(uint32_t) * entry->coverSize);
+		success = McCluskeySolver_loadCover(solver, terms, entry->coverSize);
+	}
+
+	free(primes);
+	free(terms);
+	return success;
+}
+bool McCluskeyCache_lookup(McCluskeyCache_t * restrict This, McCluskeySolver_t * restrict solver, bool * restrict hit, size_t * restrict newLayers)
+{
+	*hit = false;
+	*newLayers = 0;
+	This->pending = false;
+	if (McCluskeySolver_getBaseLayer(solver) == NULL)
+	{
+		return false;
+	}
+
+	bool cacheable;
+	if (McCluskeyCache_canonise(This, solver, &cacheable) == false)
+	{
+		return false;
+	}
+	else if (cacheable == false)
+	{
+		return true;
+	}
+
+	if (This->n_index > 0)
+	{
+		size_t slot = (size_t)This->canon.hash & (This->n_index - 1);
+		for (; This->index[slot] != 0; slot = (slot + 1) & (This->n_index - 1))
+		{
+			const size_t i = This->index[slot] - 1;
+			const size_t off   = This->entries[i];
+			const size_t avail = (off < This->n_valid) ? (This->n_valid - off) : (This->n_buf - (off - This->n_valid));
+			McCluskeyCacheEntry_t entry;
+			// Entries were checked when they were added, a failure means corruption
+			if (McCluskeyCache_readEntry(McCluskeyCache_getEntry(This, i), avail, &entry) == false)
+			{
+				return false;
+			}
+			else if (McCluskeyCache_matches(This, &entry) == false)
+			{
+				continue;
+			}
+
+			if (McCluskeyCache_load(This, &entry, solver) == false)
+			{
+				return false;
+			}
+			*hit = true;
+			*newLayers = entry.n_covers;
+			++This->n_hits;
+			return true;
+		}
+	}
+
+	This->pending = true;
+	++This->n_misses;
+	return true;
+}
+bool McCluskeyCache_store(McCluskeyCache_t * restrict This, McCluskeySolver_t * restrict solver, size_t newLayers)
+{
+	if (This->pending == false || newLayers == 0 || solver->n_set < (newLayers + 1))
+	{
+		return true;
+	}
+	This->pending = false;
+	// Covers of a search out of budget would be served as minimum on later hits
+	if (McCluskeySolver_isExpired(solver))
+	{
+		return true;
+	}
+
+	McCluskeyVals_t * coverLayer = McCluskeySolver_getLayer(solver) - (newLayers - 1);
+	// Espresso has no prime implicants, the terms of its cover are stored instead
+	McCluskeyVals_t * primes = (solver->ctx->engine == McCluskeyEngine_exact) ? coverLayer - 1 : coverLayer;
+	if (primes == McCluskeySolver_getBaseLayer(solver) || primes->n_vals > UINT32_MAX || coverLayer->n_vals > UINT32_MAX)
+	{
+		return true;
+	}
+	else if (primes->index == NULL && McCluskeyVals_buildIndex(primes) == false)
+	{
+		return false;
+	}
+
+	const McCluskeyCacheCanon_t * canon = &This->canon;
+	const uint32_t n_rows = (uint32_t)This->n_rows, n_primes = (uint32_t)primes->n_vals;
+	const uint32_t n_covers = (uint32_t)newLayers, coverSize = (uint32_t)coverLayer->n_vals;
+	const uint64_t size = MCCLUSKEYCACHE_ENTRY_HEADER + ((uint64_t)n_rows + n_primes) * MCCLUSKEYCACHE_NODE +
+		(uint64_t)n_covers * coverSize * sizeof(uint32_t);
+	const size_t off = This->n_valid + This->n_buf;
+	uint8_t * dst = McCluskeyCache_reserve(This, (size_t)size);
+	if (dst == NULL)
+	{
+		return false;
+	}
+
+	const uint8_t fields[4] = { canon->engine, canon->n_vars, canon->n_outputs, 0 };
+	dst = McCluskeyCache_put(dst, &canon->hash, sizeof(uint64_t));
+	dst = McCluskeyCache_put(dst, &size,        sizeof(uint64_t));
+	dst = McCluskeyCache_put(dst, fields,       sizeof fields);
+	dst = McCluskeyCache_put(dst, &n_rows,      sizeof(uint32_t));
+	dst = McCluskeyCache_put(dst, &n_primes,    sizeof(uint32_t));
+	dst = McCluskeyCache_put(dst, &n_covers,    sizeof(uint32_t));
+	dst = McCluskeyCache_put(dst, &coverSize,   sizeof(uint32_t));
+	for (size_t i = 0; i < n_rows; ++i)
+	{
+		const McCluskeyCacheRow_t * row = &This->rows[i];
+		dst = McCluskeyCache_putNode(dst, row->ones, row->dashes, row->onTag, row->dcTag);
+	}
+	for (size_t i = 0; i < n_primes; ++i)
+	{
+		dst = McCluskeyCache_putNode(
+			dst,
+			McCluskeyCache_permute(canon->perm, primes->ones[i] ^ (canon->neg & ~primes->dashes[i])),
+			McCluskeyCache_permute(canon->perm, primes->dashes[i]),
+			primes->onTags[i],
+			primes->dcTags[i]
+		);
+	}
+	for (size_t i = 0; i < n_covers; ++i)
+	{
+		const McCluskeyVals_t * layer = &coverLayer[i];
+		if (layer->n_vals != coverSize)
+		{
+			// Covers of different sizes are not cached, the entry is left out
+			return true;
+		}
+		for (size_t j = 0; j < coverSize; ++j)
+		{
+			const size_t idx = McCluskeyVals_find(primes, layer->ones[j], layer->dashes[j]);
+			if (idx == MCCLUSKEYVALS_NOT_FOUND)
+			{
+				return true;
+			}
+			const uint32_t term = (uint32_t)idx;
+			dst = McCluskeyCache_put(dst, &term, sizeof(uint32_t));
+		}
+	}
+
+	This->n_buf += (size_t)size;
+	return McCluskeyCache_addEntry(This, off, canon->hash);
+}
+bool McCluskeyCache_close(McCluskeyCache_t * restrict This)
+{
+	bool success = true;
+	// Only the file header of a new file is not worth writing
+	const size_t n_header = (This->n_valid == 0) ? MCCLUSKEYCACHE_FILE_HEADER : 0;
+	if (This->path != NULL && This->n_buf > n_header)
+	{
+		// Entries cut short at the end of the file are overwritten by rewriting the
+		// valid part
+		const bool rewrite = (This->n_valid < This->map.size);
+		uint8_t * valid = NULL;
+		if (rewrite)
+		{
+			valid = malloc(This->n_valid);
+			success = (valid != NULL);
+			if (success)
+			{
+				memcpy(valid, This->map.data, This->n_valid);
+			}
+		}
+		McCluskeyInputMap_close(&This->map);
+
+		FILE * file = success ? fopen(This->path, rewrite ? "wb" : "ab") : NULL;
+		success = (file != NULL) &&
+			(rewrite == false || fwrite(valid, 1, This->n_valid, file) == This->n_valid) &&
+			fwrite(This->buf, 1, This->n_buf, file) == This->n_buf;
+		if (file != NULL)
+		{
+			success = (fclose(file) == 0) && success;
+		}
+		free(valid);
+	}
+	else
+	{
+		McCluskeyInputMap_close(&This->map);
+	}
+
+	free(This->path);
+	free(This->buf);
+	free(This->entries);
+	free(This->index);
+	free(This->rows);
+	memset(This, 0, sizeof(McCluskeyCache_t));
+	return success;
+}
@@ -0,0 +1,119 @@
+#ifndef MC_CACHE_H
+#define MC_CACHE_H
+
+#include "mccluskey.h"
+#include "mcinput.h"
+
+///
+///	@brief Canonical form of a truth table, its variables are negated and then
+///	permuted. Tables equal up to negation and permutation of their variables mostly
+///	share a canonical form, variables with equal signatures keep their order
+///
+typedef struct McCluskeyCacheCanon
+{
+	// Canonical position of variable i
+	uint8_t perm[MCCLUSKEYVAL_MAX_ARGVEC];
+	// Variables negated before permuting
+	McCluskeyMask_t neg;
+	uint8_t n_vars;
+	uint8_t n_outputs;
+	McCluskeyEngine_t engine;
+
+	uint64_t hash;
+
+} McCluskeyCacheCanon_t;
+
+///
+///	@brief 1 row of a canonical truth table
+///
+typedef struct McCluskeyCacheRow
+{
+	McCluskeyMask_t ones, dashes;
+	McCluskeyTag_t onTag, dcTag;
+
+} McCluskeyCacheRow_t;
+
+///
+///	@brief Persistent cache of solved truth tables, keyed by the hash of their
+///	canonical form. The cache file is memory-mapped, all integers are in host byte
+///	order:
+///	file header: "MCCC", uint8 version (1), uint8 mask size in bytes, uint16 0
+///	per entry:   uint64 hash, uint64 size of the entry in bytes, uint8 engine,
+///	  uint8 number of variables, uint8 number of outputs, uint8 0, uint32 number of
+///	  rows, uint32 number of primes, uint32 number of covers, uint32 size of covers,
+///	  canonical rows as NODEs sorted by dashes and ones, prime NODEs, per cover
+///	  uint32 prime index per term
+///	NODE:        mask ones, mask dashes, uint32 output tag of '1', uint32 output tag
+///	  of '-'
+///	Primes are in canonical variables, for the Espresso engine they are the terms of
+///	its only cover. New entries are appended to the file by McCluskeyCache_close, the
+///	file must not be shared by concurrent processes
+///
+typedef struct McCluskeyCache
+{
+	char * path;
+	McCluskeyInputMap_t map;
+	// Length of the valid part of the file, entries after it are in buf
+	size_t n_valid;
+	// Bytes to append to the file, the file header too for a new file
+	uint8_t * buf;
+	size_t cap_buf, n_buf;
+
+	// Offsets of entries in the file followed by buf
+	size_t * entries;
+	size_t cap_entries, n_entries;
+	// Open-addressing hash index by hash, holds entry number + 1 per slot, 0 marks
+	// an empty slot
+	uint32_t * index;
+	size_t n_index;
+
+	// Canonical form of the table of the last lookup
+	McCluskeyCacheCanon_t canon;
+	McCluskeyCacheRow_t * rows;
+	size_t cap_rows, n_rows;
+	// Whether the last lookup missed a table that can be stored
+	bool pending;
+
+	size_t n_hits, n_misses;
+
+} McCluskeyCache_t;
+
+///
+///	@brief Opens a cache file, a missing file is created by McCluskeyCache_close.
+///	Entries cut short at the end of the file are ignored and overwritten
+///	@param This Pointer to cache object
+///	@param path Path of the cache file
+///	@returns Whether the operation was successful, fails if the file is not a cache
+///	file of the same mask size
+///
+bool McCluskeyCache_open(McCluskeyCache_t * restrict This, const char * restrict path);
+///
+///	@brief Looks up the table of the first layer of a solver. On a hit the cached
+///	prime implicants and covers are mapped back to the variables of the table and
+///	loaded with McCluskeySolver_loadPrimes and McCluskeySolver_loadCover, no layers
+///	need to be solved or optimised. Tables with argument vectors of different lengths
+///	are never cached
+///	@param This Pointer to cache object
+///	@param solver Pointer to the solver object, reset to a new table
+///	@param hit Pointer to variable receiving whether the table was found
+///	@param newLayers Pointer to variable receiving the number of cover layers on a hit
+///	@returns Whether the operation was successful
+///
+bool McCluskeyCache_lookup(McCluskeyCache_t * restrict This, McCluskeySolver_t * restrict solver, bool * restrict hit, size_t * restrict newLayers);
+///
+///	@brief Stores the results of the table of the last missed lookup, does nothing
+///	if there is no such table or if its covers aren't proven minimum
+///	@param This Pointer to cache object
+///	@param solver Pointer to the solver object, solved and optimised
+///	@param newLayers Number of cover layers given by McCluskeySolver_optimiseLayer
+///	@returns Whether the operation was successful
+///
+bool McCluskeyCache_store(McCluskeyCache_t * restrict This, McCluskeySolver_t * restrict solver, size_t newLayers);
+///
+///	@brief Appends the new entries to the cache file and frees the cache
+///	@param This Pointer to cache object
+///	@returns Whether the new entries were written successfully
+///
+bool McCluskeyCache_close(McCluskeyCache_t * restrict This);
+
+#endif
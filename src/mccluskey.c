@@ -1,8 +1,11 @@
 #include "mccluskey.h"
+#include "mcpool.h"
+#include "mcsimd.h"
+#include "mccover.h"
+#include "mcespresso.h"
 
 #include <string.h>
 #include <stdlib.h>
-#include <math.h>
 
 const McCluskeyState_t McCluskeyStateChars[] = {
 	['\0'] = McCluskeyState_terminator,
@@ -17,11 +20,85 @@ const char McCluskeyStateCharsRev[MCCLUSKEYSTATE_NUM] = {
 	'-'
 };
 
-static McCluskeyMode_t s_McCluskeyMode = McCluskeyMode_one;
+///
+///	@brief Default allocator of node memory
+///
+static void * McCluskeyCtx_stdAlloc(void * user, void * ptr, size_t size)
+{
+	(void)user;
+	if (size == 0)
+	{
+		free(ptr);
+		return NULL;
+	}
+	return realloc(ptr, size);
+}
+///
+///	@brief Reallocates node memory with the allocator of a context
+///
+static inline void * McCluskeyCtx_realloc(const McCluskeyCtx_t * restrict ctx, void * ptr, size_t size)
+{
+	return ctx->alloc(ctx->allocUser, ptr, size);
+}
+///
+///	@brief Frees node memory with the allocator of a context
+///
+static inline void McCluskeyCtx_free(const McCluskeyCtx_t * restrict ctx, void * ptr)
+{
+	if (ptr != NULL)
+	{
+		ctx->alloc(ctx->allocUser, ptr, 0);
+	}
+}
+
+void McCluskeyCtx_make(McCluskeyCtx_t * restrict This)
+{
+	*This = (McCluskeyCtx_t){
+		.mode      = McCluskeyMode_one,
+		.alloc     = &McCluskeyCtx_stdAlloc,
+		.allocUser = NULL,
+		.primeMode = McCluskeyPrimeMode_pairScan,
+		.engine    = McCluskeyEngine_exact,
+		.n_threads  = 1,
+		.lowMemory  = false,
+		.timeBudget = 0.0,
+		.nodeBudget = 0
+	};
+}
+void McCluskeyCtx_setMode(McCluskeyCtx_t * restrict This, char modeCh)
+{
+	This->mode = (McCluskey_getRawState(modeCh) == McCluskeyState_zero) ? McCluskeyMode_zero : McCluskeyMode_one;
+}
+void McCluskeyCtx_setAllocator(McCluskeyCtx_t * restrict This, McCluskeyAllocFunc_t alloc, void * user)
+{
+	This->alloc     = alloc;
+	This->allocUser = user;
+}
+void McCluskeyCtx_setPrimeMode(McCluskeyCtx_t * restrict This, McCluskeyPrimeMode_t mode)
+{
+	This->primeMode = mode;
+}
+void McCluskeyCtx_setEngine(McCluskeyCtx_t * restrict This, McCluskeyEngine_t engine)
+{
+	This->engine = engine;
+}
+void McCluskeyCtx_setThreads(McCluskeyCtx_t * restrict This, size_t n_threads)
+{
+	This->n_threads = n_threads;
+}
+void McCluskeyCtx_setLowMemory(McCluskeyCtx_t * restrict This, bool lowMemory)
+{
+	This->lowMemory = lowMemory;
+}
+void McCluskeyCtx_setBudget(McCluskeyCtx_t * restrict This, double seconds, uint64_t nodes)
+{
+	This->timeBudget = seconds;
+	This->nodeBudget = nodes;
+}
 
 McCluskeyState_t McCluskey_getRawState(char stateCh)
 {
-	if (stateCh > MCCLUSKEYSTATE_LAST_CHAR)
+	if ((uint8_t)stateCh > MCCLUSKEYSTATE_LAST_CHAR)
 	{
 		return 0;
 	}
@@ -42,13 +119,13 @@ char McCluskey_getRawChar(McCluskeyState_t state)
 	}
 }
 
-McCluskeyState_t McCluskey_getState(char stateCh)
+McCluskeyState_t McCluskey_getState(const McCluskeyCtx_t * restrict ctx, char stateCh)
 {
-	if (stateCh > MCCLUSKEYSTATE_LAST_CHAR)
+	if ((uint8_t)stateCh > MCCLUSKEYSTATE_LAST_CHAR)
 	{
 		return 0;
 	}
-	else if (s_McCluskeyMode == McCluskeyMode_zero)
+	else if (ctx->mode == McCluskeyMode_zero)
 	{
 		McCluskeyState_t state = McCluskeyStateChars[(uint8_t)stateCh];
 		if (state == McCluskeyState_zero)
@@ -69,13 +146,13 @@ McCluskeyState_t McCluskey_getState(char stateCh)
 		return McCluskeyStateChars[(uint8_t)stateCh];
 	}
 }
-char McCluskey_getChar(McCluskeyState_t state)
+char McCluskey_getChar(const McCluskeyCtx_t * restrict ctx, McCluskeyState_t state)
 {
 	if (state > MCCLUSKEYSTATE_NUM)
 	{
 		return -1;
 	}
-	else if (s_McCluskeyMode == McCluskeyMode_zero)
+	else if (ctx->mode == McCluskeyMode_zero)
 	{
 		if (state == McCluskeyState_zero)
 		{
@@ -96,12 +173,7 @@ char McCluskey_getChar(McCluskeyState_t state)
 	}
 }
 
-void McCluskeyVal_setMode(char modeCh)
-{
-	s_McCluskeyMode = (McCluskey_getRawState(modeCh) == McCluskeyState_zero);
-}
-
-bool McCluskeyVal_make(McCluskeyVal_t * restrict This, const char * argvec, char value)
+bool McCluskeyVal_make(McCluskeyVal_t * restrict This, const McCluskeyCtx_t * restrict ctx, const char * argvec, const char * values)
 {
 	memset(This, 0, sizeof(McCluskeyVal_t));
 	// Check for abnormalities in argvec
@@ -120,127 +192,116 @@ bool McCluskeyVal_make(McCluskeyVal_t * restrict This, const char * argvec, char
 		return false;
 	}
 
-	// Check for abnormalities in value
-	This->state = (uint8_t)(McCluskey_getState(value) & 0b11);
-	if (This->state == 0 || This->state == McCluskeyState_zero)
+	// Check for abnormalities in values
+	size_t n_outputs = 0;
+	for (; values[n_outputs] != '\0' && n_outputs < MCCLUSKEYVAL_MAX_OUTPUTS; ++n_outputs)
+	{
+		const McCluskeyTag_t bit = (McCluskeyTag_t)1 << n_outputs;
+		switch (McCluskey_getState(ctx, values[n_outputs]))
+		{
+		case McCluskeyState_one:
+			This->onTag |= bit;
+			break;
+		case McCluskeyState_undefined:
+			This->dcTag |= bit;
+			break;
+		case McCluskeyState_zero:
+			break;
+		default:
+			return false;
+		}
+	}
+	if (values[n_outputs] != '\0' || (This->onTag | This->dcTag) == 0)
 	{
 		return false;
 	}
+	This->n_outputs = (uint8_t)n_outputs;
+	This->state     = (This->onTag != 0) ? McCluskeyState_one : McCluskeyState_undefined;
 
-	for (uint8_t i = 0; i < len; ++i)
+	This->len = (uint8_t)len;
+	for (size_t i = 0; i < len; ++i)
 	{
 		// Store the value backwards
-		McCluskeyVal_putArgBit(This, i, McCluskey_getRawState(argvec[len-i-1]));
+		const McCluskeyMask_t bit = (McCluskeyMask_t)1 << (len - i - 1);
+		switch (McCluskey_getRawState(argvec[i]))
+		{
+		case McCluskeyState_one:
+			This->ones |= bit;
+			break;
+		case McCluskeyState_undefined:
+			This->dashes |= bit;
+			break;
+		}
 	}
+	This->numOnes = McCluskeyMask_popcount(This->ones);
 	return true;
 }
 McCluskeyState_t McCluskeyVal_getArgBit(const McCluskeyVal_t * restrict This, uint8_t idx)
 {
-	return (McCluskeyState_t)((This->argVec >> (idx * 2)) & 0b11);
-}
-void McCluskeyVal_putArgBit(McCluskeyVal_t * restrict This, uint8_t idx, McCluskeyState_t value)
-{
-	value &= 0b11;
-	const uint64_t zeroMask = ((uint64_t)0b11)  << (idx * 2),
-	               valMask  = ((uint64_t)value) << (idx * 2);
-	McCluskeyState_t prevState = McCluskeyVal_getArgBit(This, idx);
-	if (value == McCluskeyState_one && prevState != McCluskeyState_one)
+	if (idx >= This->len)
 	{
-		++This->numOnes;
+		return McCluskeyState_terminator;
 	}
-	else if (value != McCluskeyState_one && prevState == McCluskeyState_one)
+	const McCluskeyMask_t bit = (McCluskeyMask_t)1 << idx;
+	if (This->dashes & bit)
 	{
-		--This->numOnes;
+		return McCluskeyState_undefined;
 	}
-	This->argVec = (This->argVec & ~zeroMask) | valMask;	// OR or XOR can be used in the second part
+	return (This->ones & bit) ? McCluskeyState_one : McCluskeyState_zero;
 }
-
-bool McCluskeyVal_addParent(McCluskeyVal_t * restrict This, const McCluskeyVal_t * restrict parent)
+void McCluskeyVal_putArgBit(McCluskeyVal_t * restrict This, uint8_t idx, McCluskeyState_t value)
 {
-	if (This->n_fromVec >= This->cap_fromVec)
+	if (idx >= MCCLUSKEYVAL_MAX_ARGVEC)
 	{
-		size_t newcap = (This->n_fromVec + 1) * 2;
-		const McCluskeyVal_t ** newMem = realloc(This->fromVec, sizeof(const McCluskeyVal_t *) * newcap);
-
-		if (newMem == NULL)
-		{
-			return false;
-		}
-
-		This->fromVec     = newMem;
-		This->cap_fromVec = newcap;
+		return;
 	}
-
-	This->fromVec[This->n_fromVec] = parent;
-	++This->n_fromVec;
-
-	return true;
-}
-bool McCluskeyVal_shrinkParents(McCluskeyVal_t * restrict This)
-{
-	if (This->cap_fromVec == This->n_fromVec)
+	value &= 0b11;
+	if (value == McCluskeyState_terminator)
 	{
-		return true;
+		// Terminating the vector cuts off everything from idx upwards
+		if (idx < This->len)
+		{
+			const McCluskeyMask_t keepMask = ((McCluskeyMask_t)1 << idx) - 1;
+			This->ones   &= keepMask;
+			This->dashes &= keepMask;
+			This->len     = idx;
+		}
 	}
-	const McCluskeyVal_t ** newMem = realloc(
-		This->fromVec,
-		sizeof(const McCluskeyVal_t *) * This->n_fromVec
-	);
-
-	if (newMem == NULL)
+	else
 	{
-		return false;
+		const McCluskeyMask_t bit = (McCluskeyMask_t)1 << idx;
+		This->ones   = (This->ones   & ~bit) | ((value == McCluskeyState_one)       ? bit : 0);
+		This->dashes = (This->dashes & ~bit) | ((value == McCluskeyState_undefined) ? bit : 0);
+		if (idx >= This->len)
+		{
+			This->len = (uint8_t)(idx + 1);
+		}
 	}
-
-	This->fromVec     = newMem;
-	This->cap_fromVec = This->n_fromVec;
-
-	return true;
+	This->numOnes = McCluskeyMask_popcount(This->ones);
 }
-void McCluskeyVal_destroy(McCluskeyVal_t * restrict This)
+
+///
+///	@param lhs first operand
+///	@param rhs second operand
+///	@returns Mask of variables where the 2 argument vectors differ
+///
+static inline McCluskeyMask_t McCluskeyVal_diffMask(const McCluskeyVal_t * restrict lhs, const McCluskeyVal_t * restrict rhs)
 {
-	if (This->cap_fromVec > 0)
-	{
-		free(This->fromVec);
-		This->fromVec     = NULL;
-		This->cap_fromVec = 0;
-		This->n_fromVec   = 0;
-	}
+	return (lhs->ones ^ rhs->ones) | (lhs->dashes ^ rhs->dashes);
 }
 bool McCluskeyVal_canMerge(const McCluskeyVal_t * restrict lhs, const McCluskeyVal_t * restrict rhs)
 {
 	if (((lhs->state == McCluskeyState_one)  & (rhs->state == McCluskeyState_zero)) ||
-		((lhs->state == McCluskeyState_zero) & (rhs->state == McCluskeyState_one))
+		((lhs->state == McCluskeyState_zero) & (rhs->state == McCluskeyState_one)) ||
+		((lhs->onTag | lhs->dcTag) & (rhs->onTag | rhs->dcTag)) == 0
 	)
 	{
 		return false;
 	}
 
-	uint8_t dCounter = 0;
-	for (uint8_t i = 0; i < MCCLUSKEYVAL_MAX_ARGVEC; ++i)
-	{
-		McCluskeyState_t val1 = McCluskeyVal_getArgBit(lhs, i),
-		                 val2 = McCluskeyVal_getArgBit(rhs, i);
-		if (val1 == McCluskeyState_terminator && val2 == McCluskeyState_terminator)
-		{
-			break;
-		}
-		else if (val1 == McCluskeyState_terminator)
-		{
-			val1 = McCluskeyState_zero;
-		}
-		else if (val2 == McCluskeyState_terminator)
-		{
-			val2 = McCluskeyState_zero;
-		}
-
-		// Check for differences
-		if (val1 != val2)
-		{
-			++dCounter;
-		}
-	}
-	return !(dCounter > 1);
+	// Vectors are mergeable if they differ in at most 1 variable
+	const McCluskeyMask_t diff = McCluskeyVal_diffMask(lhs, rhs);
+	return (diff & (diff - 1)) == 0;
 }
 bool McCluskeyVal_merge(
 	McCluskeyVal_t * restrict This,
@@ -255,143 +316,39 @@ bool McCluskeyVal_merge(
 
 	memset(This, 0, sizeof(McCluskeyVal_t));
 
-	// Merging process
-	uint8_t len = McCluskeyVal_getMaxLen(vec1, vec2);
-	for (uint8_t i = 0; i < len; ++i)
-	{
-		McCluskeyState_t val1 = McCluskeyVal_getArgBit(vec1, i),
-		                 val2 = McCluskeyVal_getArgBit(vec2, i);
-	
-		if (val1 == McCluskeyState_terminator)
-		{
-			val1 = McCluskeyState_zero;
-		}
-		else if (val2 == McCluskeyState_terminator)
-		{
-			val2 = McCluskeyState_zero;
-		}
-
-		// Check for differences
-		if (val1 != val2)
-		{
-			McCluskeyVal_putArgBit(This, i, McCluskeyState_undefined);
-		}
-		else
-		{
-			McCluskeyVal_putArgBit(This, i, val1);
-		}
-	}
-
-	if (vec1->state == McCluskeyState_undefined &&
-		vec2->state == McCluskeyState_undefined
-	)
-	{
-		This->state = McCluskeyState_undefined;
-	}
-	else
-	{
-		This->state = McCluskeyState_one;
-	}
+	// Merging process, the differing variable becomes '-'
+	This->dashes  = vec1->dashes | vec2->dashes | McCluskeyVal_diffMask(vec1, vec2);
+	This->ones    = vec1->ones & vec2->ones & ~This->dashes;
+	This->len     = McCluskeyVal_getMaxLen(vec1, vec2);
+	This->numOnes = McCluskeyMask_popcount(This->ones);
 
-	if (vec1->n_fromVec == 0)
-	{
-		if (vec1->state != McCluskeyState_undefined)
-		{
-			McCluskeyVal_addParent(This, vec1);
-		}
-	}
-	else
-	{
-		for (size_t i = 0; i < vec1->n_fromVec; ++i)
-		{
-			if (vec1->fromVec[i]->state != McCluskeyState_undefined)
-			{
-				McCluskeyVal_addParent(This, vec1->fromVec[i]);
-			}
-		}
-	}
-	if (vec2->n_fromVec == 0)
-	{
-		if (vec2->state != McCluskeyState_undefined)
-		{
-			McCluskeyVal_addParent(This, vec2);
-		}
-	}
-	else
-	{
-		for (size_t i = 0; i < vec2->n_fromVec; ++i)
-		{
-			if (vec2->fromVec[i]->state != McCluskeyState_undefined)
-			{
-				McCluskeyVal_addParent(This, vec2->fromVec[i]);
-			}
-		}
-	}
-	
-	McCluskeyVal_shrinkParents(This);
+	// Merged node is an implicant of the common outputs, '-' where both are '-'
+	This->dcTag     = vec1->dcTag & vec2->dcTag;
+	This->onTag     = (vec1->onTag | vec1->dcTag) & (vec2->onTag | vec2->dcTag) & ~This->dcTag;
+	This->n_outputs = (vec1->n_outputs > vec2->n_outputs) ? vec1->n_outputs : vec2->n_outputs;
+	This->state     = (This->onTag != 0) ? McCluskeyState_one : McCluskeyState_undefined;
 
 	return true;
 }
 uint8_t McCluskeyVal_getLen(const McCluskeyVal_t * restrict This)
 {
-	uint8_t len = 0;
-	for (uint8_t i = 0; i < MCCLUSKEYVAL_MAX_ARGVEC; ++i)
-	{
-		if (McCluskeyVal_getArgBit(This, i) == McCluskeyState_terminator)
-		{
-			break;
-		}
-		else
-		{
-			len = i;
-		}
-	}
-
-	return len + 1;
+	return (This->len == 0) ? 1 : This->len;
 }
 uint8_t McCluskeyVal_getMinLen(
 	const McCluskeyVal_t * restrict vec1,
 	const McCluskeyVal_t * restrict vec2
 )
 {
-	uint8_t len = 0;
-	for (uint8_t i = 0; i < MCCLUSKEYVAL_MAX_ARGVEC; ++i)
-	{
-		McCluskeyState_t val1 = McCluskeyVal_getArgBit(vec1, i),
-		                 val2 = McCluskeyVal_getArgBit(vec2, i);
-		if ((val1 == McCluskeyState_terminator) & (val2 == McCluskeyState_terminator))
-		{
-			break;
-		}
-		else if ((val1 > McCluskeyState_zero) | (val2 > McCluskeyState_zero))
-		{
-			len = i;
-		}
-	}
-
-	return len + 1;
+	const uint8_t len = McCluskeyMask_bitLen(vec1->ones | vec1->dashes | vec2->ones | vec2->dashes);
+	return (len == 0) ? 1 : len;
 }
 uint8_t McCluskeyVal_getMaxLen(
 	const McCluskeyVal_t * restrict vec1,
 	const McCluskeyVal_t * restrict vec2
 )
 {
-	uint8_t len = 0;
-	for (uint8_t i = 0; i < MCCLUSKEYVAL_MAX_ARGVEC; ++i)
-	{
-		McCluskeyState_t val1 = McCluskeyVal_getArgBit(vec1, i),
-		                 val2 = McCluskeyVal_getArgBit(vec2, i);
-		if ((val1 == McCluskeyState_terminator) & (val2 == McCluskeyState_terminator))
-		{
-			break;
-		}
-		else
-		{
-			len = i;
-		}
-	}
-
-	return len + 1;
+	const uint8_t len = (vec1->len > vec2->len) ? vec1->len : vec2->len;
+	return (len == 0) ? 1 : len;
 }
 
 ///
@@ -424,207 +381,695 @@ bool McCluskeyVal_getVecStr(const McCluskeyVal_t * restrict This, char * restric
 
 	return true;
 }
-char McCluskeyVal_getStateCh(const McCluskeyVal_t * restrict This)
-{
-	return McCluskey_getChar(This->state);
-}
-bool McCluskeyVal_equal(const McCluskeyVal_t * restrict vec1, const McCluskeyVal_t * restrict vec2)
-{
-	uint8_t len = McCluskeyVal_getMinLen(vec1, vec2);
-	uint64_t eqMask = (~((uint64_t)0)) >> (2 * (MCCLUSKEYVAL_MAX_ARGVEC - len));
-	return (vec1->argVec & eqMask) == (vec2->argVec & eqMask);
-}
-
-
-
-void McCluskeyVals_make(McCluskeyVals_t * restrict This)
+char McCluskeyVal_getStateCh(const McCluskeyVal_t * restrict This, const McCluskeyCtx_t * restrict ctx)
 {
-	memset(This, 0, sizeof(McCluskeyVals_t));
+	return McCluskey_getChar(ctx, This->state);
 }
-bool McCluskeyVals_push(McCluskeyVals_t * restrict This, const McCluskeyVal_t * restrict val)
+bool McCluskeyVal_getOutStr(const McCluskeyVal_t * restrict This, const McCluskeyCtx_t * restrict ctx, char * restrict str, size_t maxStr)
 {
-	if (This->n_vals >= This->cap_vals)
+	const size_t n_outputs = (This->n_outputs == 0) ? 1 : This->n_outputs;
+	if (maxStr <= n_outputs)
 	{
-		size_t newcap = (This->n_vals + 1) * 2;
-		McCluskeyVal_t ** newmem = realloc(This->vals, sizeof(McCluskeyVal_t *) * newcap);
-
-		if (newmem == NULL)
-		{
-			return false;
-		}
-
-		This->vals     = newmem;
-		This->cap_vals = newcap;
+		return false;
 	}
 
-
-	This->vals[This->n_vals] = malloc(sizeof(McCluskeyVal_t));
-	if (This->vals[This->n_vals] == NULL)
+	for (size_t i = 0; i < n_outputs; ++i)
 	{
-		return false;
+		const McCluskeyTag_t bit = (McCluskeyTag_t)1 << i;
+		str[i] = McCluskey_getChar(ctx, (This->onTag & bit) ? McCluskeyState_one :
+			(This->dcTag & bit) ? McCluskeyState_undefined : McCluskeyState_zero);
 	}
-	*This->vals[This->n_vals] = *val;
-	++This->n_vals;
+	str[n_outputs] = '\0';
 
 	return true;
 }
-bool McCluskeyVals_pop(McCluskeyVals_t * restrict This)
+bool McCluskeyVal_equal(const McCluskeyVal_t * restrict vec1, const McCluskeyVal_t * restrict vec2)
 {
-	if (This->n_vals == 0)
-	{
-		return false;
-	}
+	return McCluskeyVal_diffMask(vec1, vec2) == 0;
+}
 
-	--This->n_vals;
-	McCluskeyVal_destroy(This->vals[This->n_vals]);
-	free(This->vals[This->n_vals]);
 
-	return true;
-}
-McCluskeyVal_t * McCluskeyVals_getLast(McCluskeyVals_t * restrict This)
+
+void McCluskeyVals_make(McCluskeyVals_t * restrict This, const McCluskeyCtx_t * restrict ctx)
 {
-	if (This->n_vals == 0)
-	{
-		return NULL;
-	}
-	else
-	{
-		return This->vals[This->n_vals - 1];
-	}
+	memset(This, 0, sizeof(McCluskeyVals_t));
+	This->ctx = ctx;
 }
-bool McCluskeyVals_shrink(McCluskeyVals_t * restrict This)
-{
-	if (This->cap_vals == This->n_vals)
-	{
-		return true;
-	}
-
-	McCluskeyVal_t ** newmem = realloc(This->vals, sizeof(McCluskeyVal_t *) * This->n_vals);
 
-	if (newmem == NULL)
-	{
-		return false;
-	}
+///
+///	@brief Reallocates array to hold cap elements, returns false from the calling
+///	function on failure
+///
+#define MCCLUSKEY_REALLOC_ARR(ctx, arr, cap) do {				\
+	void * mem_ = McCluskeyCtx_realloc((ctx), (arr), sizeof(*(arr)) * (cap));	\
+	if (mem_ == NULL && (cap) > 0)								\
+	{															\
+		return false;											\
+	}															\
+	(arr) = mem_;												\
+} while (0)
 
-	This->vals     = newmem;
-	This->cap_vals = This->n_vals;
+///
+///	@brief Swaps 2 variables of the same type
+///
+#define MCCLUSKEY_SWAP(a, b) do {								\
+	const __typeof__(a) tmp_ = (a);								\
+	(a) = (b);													\
+	(b) = tmp_;													\
+} while (0)
 
-	return true;
+///
+///	@brief Mixes 64-bit key into a well-distributed hash value
+///
+static inline uint64_t McCluskey_hashKey(uint64_t key)
+{
+	key ^= key >> 30;
+	key *= UINT64_C(0xbf58476d1ce4e5b9);
+	key ^= key >> 27;
+	key *= UINT64_C(0x94d049bb133111eb);
+	key ^= key >> 31;
+	return key;
 }
-void McCluskeyVals_destroy(McCluskeyVals_t * restrict This)
+///
+///	@returns Slot of index holding the node with given argument vector, the empty
+///	slot where such node would be inserted if it doesn't exist
+///
+static inline size_t McCluskeyVals_indexSlot(
+	const McCluskeyVals_t * restrict This,
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes
+)
 {
-	if (This->cap_vals > 0)
+	const size_t mask = This->n_index - 1;
+	size_t slot = (size_t)McCluskey_hashKey(McCluskeyMask_key(ones, dashes)) & mask;
+	while (This->index[slot] != 0)
 	{
-		for (size_t i = 0; i < This->n_vals; ++i)
+		const size_t idx = This->index[slot] - 1;
+		if ((This->ones[idx] == ones) & (This->dashes[idx] == dashes))
 		{
-			McCluskeyVal_destroy(This->vals[i]);
-			free(This->vals[i]);
+			break;
 		}
-		free(This->vals);
-		This->vals     = NULL;
-		This->cap_vals = 0;
-		This->n_vals   = 0;
+		slot = (slot + 1) & mask;
 	}
+	return slot;
 }
-void McCluskeyVals_destroyPreserveParents(McCluskeyVals_t * restrict This)
+///
+///	@brief Adds node idx to index, index has to have free slots
+///
+static inline void McCluskeyVals_indexInsert(McCluskeyVals_t * restrict This, size_t idx)
 {
-	if (This->cap_vals > 0)
+	const size_t slot = McCluskeyVals_indexSlot(This, This->ones[idx], This->dashes[idx]);
+	if (This->index[slot] == 0)
 	{
-		for (size_t i = 0; i < This->n_vals; ++i)
-		{
-			free(This->vals[i]);
-		}
-		free(This->vals);
-		This->vals     = NULL;
-		This->cap_vals = 0;
-		This->n_vals   = 0;
+		This->index[slot] = (uint32_t)(idx + 1);
 	}
 }
-void McCluskeyVals_removeDuplicates(McCluskeyVals_t * restrict This)
+///
+///	@brief Removes node idx from index, closing the gap in the probe sequence
+///
+static inline void McCluskeyVals_indexErase(McCluskeyVals_t * restrict This, size_t idx)
 {
-	if (This->n_vals < 2)
+	const size_t mask = This->n_index - 1;
+	size_t slot = McCluskeyVals_indexSlot(This, This->ones[idx], This->dashes[idx]);
+	if (This->index[slot] != (uint32_t)(idx + 1))
 	{
 		return;
 	}
 
-	for (size_t i = 1; i < This->n_vals;)
+	size_t next = slot;
+	while (1)
 	{
-		bool found = false;
-		for (size_t j = i; j > 0; --j)
+		This->index[slot] = 0;
+		size_t home;
+		do
 		{
-			if (This->vals[j - 1]->numOnes != This->vals[i]->numOnes)
-			{
-				break;
-			}
-			else if (McCluskeyVal_equal(This->vals[j - 1], This->vals[i]))
+			next = (next + 1) & mask;
+			if (This->index[next] == 0)
 			{
-				found = true;
-				break;
+				return;
 			}
-		}
-		if (found)
-		{
-			McCluskeyVal_destroy(This->vals[i]);
-			free(This->vals[i]);
-			memmove(&This->vals[i], &This->vals[i+1], sizeof(McCluskeyVal_t *) * (This->n_vals - i - 1));
-			--This->n_vals;
-		}
-		else
-		{
-			++i;
-		}
+			const size_t other = This->index[next] - 1;
+			home = (size_t)McCluskey_hashKey(McCluskeyMask_key(This->ones[other], This->dashes[other])) & mask;
+		// Entry can't be moved if its home slot lies cyclically in (slot, next]
+		} while ((slot <= next) ? ((slot < home) && (home <= next)) : ((slot < home) || (home <= next)));
+
+		This->index[slot] = This->index[next];
+		slot = next;
 	}
 }
-
 ///
-///	@brief Compare function for sorting McCluskeyVal_t objects by the number of ones
-///	in the input argument vectors
+///	@brief (Re)builds index to hold at least minNodes nodes, indexes all current nodes
+///	@returns Whether the operation was successful
 ///
-static inline int McCluskeyVals_comp(const void * a, const void * b)
+static inline bool McCluskeyVals_indexGrow(McCluskeyVals_t * restrict This, size_t minNodes)
 {
-	return (int)(*((const McCluskeyVal_t **)a))->numOnes - (int)(*((const McCluskeyVal_t **)b))->numOnes;
-}
-void McCluskeyVals_sort(McCluskeyVals_t * restrict This)
-{
-	if (This->n_vals < 2)
+	size_t n_index = 16;
+	while (n_index < (minNodes * 2))
 	{
-		return;
+		n_index *= 2;
 	}
 
-	qsort(This->vals, This->n_vals, sizeof(McCluskeyVal_t *), &McCluskeyVals_comp);
-}
-
-
-bool McCluskeySolver_make(McCluskeySolver_t * restrict This, McCluskeyVals_t * restrict source)
-{
-	memset(This, 0, sizeof(McCluskeySolver_t));
-	if (McCluskeySolver_pushLayer(This) == false)
+	if (n_index == This->n_index)
 	{
-		return false;
+		memset(This->index, 0, sizeof(uint32_t) * n_index);
+	}
+	else
+	{
+		uint32_t * newmem = McCluskeyCtx_realloc(This->ctx, NULL, sizeof(uint32_t) * n_index);
+		if (newmem == NULL)
+		{
+			return false;
+		}
+		memset(newmem, 0, sizeof(uint32_t) * n_index);
+		McCluskeyCtx_free(This->ctx, This->index);
+		This->index   = newmem;
+		This->n_index = n_index;
+	}
+
+	for (size_t i = 0; i < This->n_vals; ++i)
+	{
+		McCluskeyVals_indexInsert(This, i);
+	}
+
+	return true;
+}
+
+bool McCluskeyVals_reserve(McCluskeyVals_t * restrict This, size_t cap)
+{
+	if (cap <= This->cap_vals)
+	{
+		return true;
+	}
+	else if (cap > UINT32_MAX)
+	{
+		return false;
+	}
+
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->ones,      cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->dashes,    cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->onTags,    cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->dcTags,    cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->lens,      cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->numOnes,   cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->states,    cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->parentOff, cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->parentCnt, cap);
+
+	This->cap_vals = cap;
+	return true;
+}
+bool McCluskeyVals_push(McCluskeyVals_t * restrict This, const McCluskeyVal_t * restrict val)
+{
+	if (This->n_vals >= This->cap_vals &&
+		McCluskeyVals_reserve(This, (This->n_vals + 1) * 2) == false
+	)
+	{
+		return false;
+	}
+
+	if (This->index != NULL && ((This->n_vals + 1) * 2) > This->n_index &&
+		McCluskeyVals_indexGrow(This, This->n_vals + 1) == false
+	)
+	{
+		return false;
+	}
+
+	const size_t idx = This->n_vals;
+	This->ones[idx]      = val->ones;
+	This->dashes[idx]    = val->dashes;
+	This->onTags[idx]    = val->onTag;
+	This->dcTags[idx]    = val->dcTag;
+	This->lens[idx]      = val->len;
+	This->numOnes[idx]   = val->numOnes;
+	This->states[idx]    = val->state;
+	This->parentOff[idx] = This->n_parents;
+	This->parentCnt[idx] = 0;
+	++This->n_vals;
+	This->n_outputs = (val->n_outputs > This->n_outputs) ? val->n_outputs : This->n_outputs;
+
+	if (This->index != NULL)
+	{
+		McCluskeyVals_indexInsert(This, idx);
+	}
+
+	return true;
+}
+///
+///	@brief Adds output tags to node idx
+///
+static inline void McCluskeyVals_addTags(
+	McCluskeyVals_t * restrict This,
+	size_t idx,
+	McCluskeyTag_t onTag,
+	McCluskeyTag_t dcTag
+)
+{
+	This->onTags[idx] |= onTag;
+	This->dcTags[idx]  = (This->dcTags[idx] | dcTag) & ~This->onTags[idx];
+	This->states[idx]  = (This->onTags[idx] != 0) ? McCluskeyState_one : McCluskeyState_undefined;
+}
+///
+///	@brief Pushes node unless an equal node exists at index since or later, output
+///	tags are then added to the existing node. An equal node before index since is
+///	shadowed in the index by the new node
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyVals_pushUniqueSince_impl(
+	McCluskeyVals_t * restrict This,
+	const McCluskeyVal_t * restrict val,
+	size_t since,
+	bool * restrict inserted
+)
+{
+	*inserted = false;
+	if (This->index == NULL && McCluskeyVals_buildIndex(This) == false)
+	{
+		return false;
+	}
+	const uint32_t entry = This->index[McCluskeyVals_indexSlot(This, val->ones, val->dashes)];
+	if (entry != 0 && (size_t)(entry - 1) >= since)
+	{
+		McCluskeyVals_addTags(This, entry - 1, val->onTag, val->dcTag);
+		return true;
+	}
+	else if (McCluskeyVals_push(This, val) == false)
+	{
+		return false;
+	}
+	else if (entry != 0)
+	{
+		This->index[McCluskeyVals_indexSlot(This, val->ones, val->dashes)] = (uint32_t)This->n_vals;
+	}
+
+	*inserted = true;
+	return true;
+}
+bool McCluskeyVals_pushUnique(McCluskeyVals_t * restrict This, const McCluskeyVal_t * restrict val, bool * restrict inserted)
+{
+	return McCluskeyVals_pushUniqueSince_impl(This, val, 0, inserted);
+}
+bool McCluskeyVals_pushFrom(McCluskeyVals_t * restrict This, const McCluskeyVals_t * restrict src, size_t idx)
+{
+	McCluskeyVal_t val;
+	McCluskeyVals_get(src, idx, &val);
+
+	uint32_t n_parents;
+	const uint32_t * parents = McCluskeyVals_getParents(src, idx, &n_parents);
+
+	return McCluskeyVals_push(This, &val) &&
+		McCluskeyVals_addParents(This, This->n_vals - 1, parents, n_parents);
+}
+bool McCluskeyVals_addParents(
+	McCluskeyVals_t * restrict This,
+	size_t idx,
+	const uint32_t * restrict parents,
+	uint32_t n_parents
+)
+{
+	if (idx >= This->n_vals)
+	{
+		return false;
+	}
+	else if (This->parentCnt[idx] == 0)
+	{
+		This->parentOff[idx] = This->n_parents;
+	}
+	else if ((This->parentOff[idx] + This->parentCnt[idx]) != This->n_parents ||
+		(This->parentCnt[idx] + (uint64_t)n_parents) > UINT32_MAX
+	)
+	{
+		return false;
+	}
+
+	if ((This->n_parents + n_parents) > This->cap_parents)
+	{
+		size_t newcap = (This->n_parents + n_parents) * 2;
+		MCCLUSKEY_REALLOC_ARR(This->ctx, This->parents, newcap);
+		This->cap_parents = newcap;
+	}
+
+	if (n_parents > 0)
+	{
+		memcpy(&This->parents[This->n_parents], parents, sizeof(uint32_t) * n_parents);
+	}
+	This->n_parents      += n_parents;
+	This->parentCnt[idx] += n_parents;
+
+	return true;
+}
+bool McCluskeyVals_buildIndex(McCluskeyVals_t * restrict This)
+{
+	return McCluskeyVals_indexGrow(This, This->n_vals);
+}
+size_t McCluskeyVals_find(const McCluskeyVals_t * restrict This, McCluskeyMask_t ones, McCluskeyMask_t dashes)
+{
+	if (This->index == NULL)
+	{
+		return MCCLUSKEYVALS_NOT_FOUND;
+	}
+
+	const uint32_t entry = This->index[McCluskeyVals_indexSlot(This, ones, dashes)];
+	return (entry == 0) ? MCCLUSKEYVALS_NOT_FOUND : (size_t)(entry - 1);
+}
+void McCluskeyVals_get(const McCluskeyVals_t * restrict This, size_t idx, McCluskeyVal_t * restrict val)
+{
+	val->ones    = This->ones[idx];
+	val->dashes    = This->dashes[idx];
+	val->onTag     = This->onTags[idx];
+	val->dcTag     = This->dcTags[idx];
+	val->len       = This->lens[idx];
+	val->numOnes   = This->numOnes[idx];
+	val->n_outputs = This->n_outputs;
+	val->state     = This->states[idx];
+}
+const uint32_t * McCluskeyVals_getParents(const McCluskeyVals_t * restrict This, size_t idx, uint32_t * restrict n_parents)
+{
+	*n_parents = This->parentCnt[idx];
+	return (This->parentCnt[idx] == 0) ? NULL : &This->parents[This->parentOff[idx]];
+}
+bool McCluskeyVals_pop(McCluskeyVals_t * restrict This)
+{
+	if (This->n_vals == 0)
+	{
+		return false;
+	}
+
+	if (This->index != NULL)
+	{
+		McCluskeyVals_indexErase(This, This->n_vals - 1);
+	}
+
+	--This->n_vals;
+	// Release parent references if they were the last ones in the pool
+	if ((This->parentOff[This->n_vals] + This->parentCnt[This->n_vals]) == This->n_parents)
+	{
+		This->n_parents = This->parentOff[This->n_vals];
+	}
+
+	return true;
+}
+bool McCluskeyVals_shrink(McCluskeyVals_t * restrict This)
+{
+	if (This->cap_parents != This->n_parents)
+	{
+		MCCLUSKEY_REALLOC_ARR(This->ctx, This->parents, This->n_parents);
+		This->cap_parents = This->n_parents;
+	}
+	if (This->cap_vals == This->n_vals)
+	{
+		return true;
+	}
+
+	const size_t cap = This->n_vals;
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->ones,      cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->dashes,    cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->onTags,    cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->dcTags,    cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->lens,      cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->numOnes,   cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->states,    cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->parentOff, cap);
+	MCCLUSKEY_REALLOC_ARR(This->ctx, This->parentCnt, cap);
+
+	This->cap_vals = cap;
+	return true;
+}
+void McCluskeyVals_clear(McCluskeyVals_t * restrict This)
+{
+	This->n_vals    = 0;
+	This->n_parents = 0;
+	This->n_outputs = 0;
+	if (This->index != NULL)
+	{
+		memset(This->index, 0, sizeof(uint32_t) * This->n_index);
+	}
+}
+void McCluskeyVals_destroy(McCluskeyVals_t * restrict This)
+{
+	const McCluskeyCtx_t * ctx = This->ctx;
+	McCluskeyCtx_free(ctx, This->ones);
+	McCluskeyCtx_free(ctx, This->dashes);
+	McCluskeyCtx_free(ctx, This->onTags);
+	McCluskeyCtx_free(ctx, This->dcTags);
+	McCluskeyCtx_free(ctx, This->lens);
+	McCluskeyCtx_free(ctx, This->numOnes);
+	McCluskeyCtx_free(ctx, This->states);
+	McCluskeyCtx_free(ctx, This->parentOff);
+	McCluskeyCtx_free(ctx, This->parentCnt);
+	McCluskeyCtx_free(ctx, This->parents);
+	McCluskeyCtx_free(ctx, This->index);
+	McCluskeyVals_make(This, ctx);
+}
+///
+///	@brief Moves node from index src to index dst inside the same array of nodes
+///
+static inline void McCluskeyVals_move(McCluskeyVals_t * restrict This, size_t dst, size_t src)
+{
+	This->ones[dst]      = This->ones[src];
+	This->dashes[dst]    = This->dashes[src];
+	This->onTags[dst]    = This->onTags[src];
+	This->dcTags[dst]    = This->dcTags[src];
+	This->lens[dst]      = This->lens[src];
+	This->numOnes[dst]   = This->numOnes[src];
+	This->states[dst]    = This->states[src];
+	This->parentOff[dst] = This->parentOff[src];
+	This->parentCnt[dst] = This->parentCnt[src];
+}
+///
+///	@brief Removes node idx by moving the last node to its place
+///	@returns Number of parent references of the node left in the pool as garbage
+///
+static inline size_t McCluskeyVals_swapRemove(McCluskeyVals_t * restrict This, size_t idx)
+{
+	const size_t last = This->n_vals - 1;
+	size_t garbage = This->parentCnt[idx];
+	if ((This->parentOff[idx] + This->parentCnt[idx]) == This->n_parents)
+	{
+		This->n_parents = This->parentOff[idx];
+		garbage = 0;
+	}
+
+	if (This->index != NULL)
+	{
+		McCluskeyVals_indexErase(This, idx);
+		if (idx != last)
+		{
+			McCluskeyVals_indexErase(This, last);
+		}
+	}
+	if (idx != last)
+	{
+		McCluskeyVals_move(This, idx, last);
+	}
+	--This->n_vals;
+	if (This->index != NULL && idx != last)
+	{
+		McCluskeyVals_indexInsert(This, idx);
+	}
+
+	return garbage;
+}
+///
+///	@brief Rewrites the parent pool in node order without garbage
+///	@param n_live Number of parent references owned by nodes
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyVals_compactParents(McCluskeyVals_t * restrict This, size_t n_live)
+{
+	uint32_t * pool = McCluskeyCtx_realloc(This->ctx, NULL, sizeof(uint32_t) * (n_live + 1));
+	if (pool == NULL)
+	{
+		return false;
+	}
+
+	size_t n = 0;
+	for (size_t i = 0; i < This->n_vals; ++i)
+	{
+		if (This->parentCnt[i] > 0)
+		{
+			memcpy(&pool[n], &This->parents[This->parentOff[i]], sizeof(uint32_t) * This->parentCnt[i]);
+		}
+		This->parentOff[i] = n;
+		n += This->parentCnt[i];
+	}
+
+	McCluskeyCtx_free(This->ctx, This->parents);
+	This->parents     = pool;
+	This->cap_parents = n_live + 1;
+	This->n_parents   = n;
+	return true;
+}
+bool McCluskeyVals_removeDuplicates(McCluskeyVals_t * restrict This)
+{
+	const size_t n_vals = This->n_vals;
+	This->n_vals = 0;
+	// Index is rebuilt over the unique nodes only
+	if (McCluskeyVals_indexGrow(This, n_vals) == false)
+	{
+		This->n_vals = n_vals;
+		return false;
+	}
+
+	for (size_t i = 0; i < n_vals; ++i)
+	{
+		const size_t slot = McCluskeyVals_indexSlot(This, This->ones[i], This->dashes[i]);
+		if (This->index[slot] == 0)
+		{
+			McCluskeyVals_move(This, This->n_vals, i);
+			This->index[slot] = (uint32_t)(This->n_vals + 1);
+			++This->n_vals;
+		}
+		else
+		{
+			McCluskeyVals_addTags(This, This->index[slot] - 1, This->onTags[i], This->dcTags[i]);
+		}
+	}
+
+	return true;
+}
+bool McCluskeyVals_sort(McCluskeyVals_t * restrict This)
+{
+	McCluskeyVals_t scratch;
+	McCluskeyVals_make(&scratch, This->ctx);
+	const bool success = McCluskeyVals_sortWith(This, &scratch);
+	McCluskeyVals_destroy(&scratch);
+	return success;
+}
+bool McCluskeyVals_sortWith(McCluskeyVals_t * restrict This, McCluskeyVals_t * restrict scratch)
+{
+	if (This->n_vals < 2)
+	{
+		return true;
+	}
+
+	// Stable counting sort by the number of ones
+	size_t offsets[MCCLUSKEYVAL_MAX_ARGVEC + 2] = { 0 };
+	for (size_t i = 0; i < This->n_vals; ++i)
+	{
+		++offsets[This->numOnes[i] + 1];
+	}
+	for (size_t i = 1; i < (MCCLUSKEYVAL_MAX_ARGVEC + 2); ++i)
+	{
+		offsets[i] += offsets[i - 1];
+	}
+
+	scratch->n_vals = 0;
+	if (McCluskeyVals_reserve(scratch, This->n_vals) == false)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < This->n_vals; ++i)
+	{
+		const size_t dst = offsets[This->numOnes[i]]++;
+		scratch->ones[dst]      = This->ones[i];
+		scratch->dashes[dst]    = This->dashes[i];
+		scratch->onTags[dst]    = This->onTags[i];
+		scratch->dcTags[dst]    = This->dcTags[i];
+		scratch->lens[dst]      = This->lens[i];
+		scratch->numOnes[dst]   = This->numOnes[i];
+		scratch->states[dst]    = This->states[i];
+		scratch->parentOff[dst] = This->parentOff[i];
+		scratch->parentCnt[dst] = This->parentCnt[i];
+	}
+
+	// Parent pool and index stay in place
+	MCCLUSKEY_SWAP(This->ones,      scratch->ones);
+	MCCLUSKEY_SWAP(This->dashes,    scratch->dashes);
+	MCCLUSKEY_SWAP(This->onTags,    scratch->onTags);
+	MCCLUSKEY_SWAP(This->dcTags,    scratch->dcTags);
+	MCCLUSKEY_SWAP(This->lens,      scratch->lens);
+	MCCLUSKEY_SWAP(This->numOnes,   scratch->numOnes);
+	MCCLUSKEY_SWAP(This->states,    scratch->states);
+	MCCLUSKEY_SWAP(This->parentOff, scratch->parentOff);
+	MCCLUSKEY_SWAP(This->parentCnt, scratch->parentCnt);
+	MCCLUSKEY_SWAP(This->cap_vals,  scratch->cap_vals);
+
+	// Node indices have changed
+	return (This->index == NULL) || McCluskeyVals_buildIndex(This);
+}
+
+
+bool McCluskeySolver_make(McCluskeySolver_t * restrict This, const McCluskeyCtx_t * restrict ctx, McCluskeyVals_t * restrict source)
+{
+	memset(This, 0, sizeof(McCluskeySolver_t));
+	This->ctx = ctx;
+	McCluskeyVals_make(&This->scratch, ctx);
+	McCluskeyVals_make(&This->edits, ctx);
+
+	if (McCluskeySolver_reset(This, source) == false)
+	{
+		McCluskeySolver_destroy(This);
+		return false;
 	}
-
-	This->set[0] = *source;
-	memset(source, 0, sizeof(McCluskeyVals_t));
 	
 	return true;
 }
+///
+///	@brief Makes every defined input node of the first layer its own parent
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeySolver_selfParents_impl(McCluskeyVals_t * restrict base)
+{
+	for (size_t i = 0; i < base->n_vals; ++i)
+	{
+		const uint32_t self = (uint32_t)i;
+		if (base->states[i] != McCluskeyState_undefined &&
+			McCluskeyVals_addParents(base, i, &self, 1) == false
+		)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+bool McCluskeySolver_reset(McCluskeySolver_t * restrict This, McCluskeyVals_t * restrict source)
+{
+	while (This->n_set > 0)
+	{
+		McCluskeySolver_popLayer(This);
+	}
+	This->n_covers = 0;
+	This->editable = false;
+	This->layered  = true;
+	This->expired  = false;
+	This->stats    = (McCluskeyStats_t){ 0 };
+	McCluskeyVals_clear(&This->edits);
+	if (McCluskeySolver_pushLayer(This) == false)
+	{
+		return false;
+	}
+
+	// Source data becomes the first layer, source receives the old memory
+	McCluskeyVals_t * base = &This->set[0];
+	MCCLUSKEY_SWAP(*base, *source);
+
+	// Every defined input node is its own parent
+	return (base->n_parents != 0) || McCluskeySolver_selfParents_impl(base);
+}
 bool McCluskeySolver_pushLayer(McCluskeySolver_t * restrict This)
 {
 	if (This->n_set >= This->cap_set)
 	{
 		size_t newcap = (This->n_set + 1) * 2;
-		McCluskeyVals_t * newmem = realloc(This->set, sizeof(McCluskeyVals_t) * newcap);
+		McCluskeyVals_t * newmem = McCluskeyCtx_realloc(This->ctx, This->set, sizeof(McCluskeyVals_t) * newcap);
 		
 		if (newmem == NULL)
 		{
 			return false;
 		}
 
-		This->set     = newmem;
+		for (size_t i = This->cap_set; i < newcap; ++i)
+		{
+			McCluskeyVals_make(&newmem[i], This->ctx);
+		}
+		This->set = newmem;
+
+		MCCLUSKEY_REALLOC_ARR(This->ctx, This->info, newcap);
 		This->cap_set = newcap;
 	}
 
-	McCluskeyVals_make(&This->set[This->n_set]);
+	McCluskeyVals_clear(&This->set[This->n_set]);
+	This->info[This->n_set] = (McCluskeyLayerInfo_t){ 0 };
 	++This->n_set;
 
 	return true;
@@ -637,7 +1082,7 @@ bool McCluskeySolver_popLayer(McCluskeySolver_t * restrict This)
 	}
 
 	--This->n_set;
-	McCluskeyVals_destroy(&This->set[This->n_set]);
+	McCluskeyVals_clear(&This->set[This->n_set]);
 
 	return true;
 }
@@ -645,657 +1090,1797 @@ void McCluskeySolver_destroy(McCluskeySolver_t * restrict This)
 {
 	if (This->cap_set > 0)
 	{
-		for (size_t i = 0; i < This->n_set; ++i)
+		for (size_t i = 0; i < This->cap_set; ++i)
 		{
 			McCluskeyVals_destroy(&This->set[i]);
 		}
-		free(This->set);
+		McCluskeyCtx_free(This->ctx, This->set);
+		McCluskeyCtx_free(This->ctx, This->info);
 		This->set     = NULL;
+		This->info    = NULL;
 		This->cap_set = 0;
 		This->n_set   = 0;
 	}
+	McCluskeyVals_destroy(&This->scratch);
+	McCluskeyVals_destroy(&This->edits);
+	McCluskeyCtx_free(This->ctx, This->connected);
+	This->connected     = NULL;
+	This->cap_connected = 0;
+}
+
+///
+///	@brief Marks node idx in bitset
+///
+static inline void McCluskey_bitsetSet(uint64_t * restrict bitset, size_t idx)
+{
+	bitset[idx / 64] |= (uint64_t)1 << (idx % 64);
+}
+///
+///	@returns Whether node idx is marked in bitset
+///
+static inline bool McCluskey_bitsetGet(const uint64_t * restrict bitset, size_t idx)
+{
+	return (bitset[idx / 64] >> (idx % 64)) & 1;
 }
 
-bool McCluskeySolver_solveLayer(McCluskeySolver_t * restrict This)
+///
+///	@brief Merges 2 nodes of source layer and adds the result to destination layer,
+///	unless the destination layer already contains it at index since or later. Nodes
+///	without common outputs aren't merged. A node is marked as connected if the
+///	merged node keeps all of its outputs
+///	@param layer Destination layer
+///	@param since Index of destination layer from which on duplicates are checked
+///	@param prevLayer Source layer
+///	@param hasConnected Bitset receiving nodes of source layer that were merged
+///	@param stats Pointer to counters of merges
+///	@param j Index of first node
+///	@param k Index of second node, has to be mergeable with the first node
+///	@returns Whether the operation was successful
+///
+static inline bool solveLayer_pushMerged_impl(
+	McCluskeyVals_t * restrict layer,
+	size_t since,
+	const McCluskeyVals_t * restrict prevLayer,
+	uint64_t * restrict hasConnected,
+	McCluskeyStats_t * restrict stats,
+	size_t j,
+	size_t k
+)
 {
-	if (McCluskeySolver_getLayer(This) == NULL || McCluskeySolver_pushLayer(This) == false)
+	const McCluskeyTag_t tagJ = prevLayer->onTags[j] | prevLayer->dcTags[j];
+	const McCluskeyTag_t tagK = prevLayer->onTags[k] | prevLayer->dcTags[k];
+	if ((tagJ & tagK) == 0)
 	{
-		return false;
+		return true;
 	}
-	McCluskeyVals_t * layer = McCluskeySolver_getLayer(This);
-	const McCluskeyVals_t * prevLayer = layer - 1;
-
-	// Create boundaries
-	size_t boundaries[MCCLUSKEYVAL_MAX_ARGVEC] = { 0 };
-	uint8_t prevOnes = 0;
-	for (size_t i = 0; i < prevLayer->n_vals; ++i)
+	MCCLUSKEY_STAT(++stats->merges);
+	if ((tagJ & ~tagK) == 0)
 	{
-		if (prevLayer->vals[i]->numOnes != prevOnes)
+		McCluskey_bitsetSet(hasConnected, j);
+	}
+	if ((tagK & ~tagJ) == 0)
+	{
+		McCluskey_bitsetSet(hasConnected, k);
+	}
+
+	const McCluskeyMask_t dashes = prevLayer->dashes[j] | prevLayer->dashes[k] |
+		(prevLayer->ones[j] ^ prevLayer->ones[k]);
+	const McCluskeyTag_t dcTag = prevLayer->dcTags[j] & prevLayer->dcTags[k];
+	const McCluskeyVal_t newVec = {
+		.ones      = prevLayer->ones[j] & prevLayer->ones[k] & ~dashes,
+		.dashes    = dashes,
+		.onTag     = tagJ & tagK & ~dcTag,
+		.dcTag     = dcTag,
+		.len       = (prevLayer->lens[j] > prevLayer->lens[k]) ? prevLayer->lens[j] : prevLayer->lens[k],
+		.numOnes   = (prevLayer->numOnes[j] < prevLayer->numOnes[k]) ? prevLayer->numOnes[j] : prevLayer->numOnes[k],
+		.n_outputs = prevLayer->n_outputs,
+		.state     = ((tagJ & tagK & ~dcTag) != 0) ? McCluskeyState_one : McCluskeyState_undefined
+	};
+
+	bool inserted;
+	if (McCluskeyVals_pushUniqueSince_impl(layer, &newVec, since, &inserted) == false)
+	{
+		return false;
+	}
+	else if (inserted == false)
+	{
+		// Same interval has already been generated from another pair
+		MCCLUSKEY_STAT(++stats->duplicates);
+		return true;
+	}
+
+	uint32_t n1, n2;
+	const uint32_t * p1 = McCluskeyVals_getParents(prevLayer, j, &n1),
+	               * p2 = McCluskeyVals_getParents(prevLayer, k, &n2);
+
+	const size_t idx = layer->n_vals - 1;
+	if (McCluskeyVals_addParents(layer, idx, p1, n1) == false)
+	{
+		return false;
+	}
+	else if ((prevLayer->dashes[j] ^ prevLayer->dashes[k]) == 0)
+	{
+		return McCluskeyVals_addParents(layer, idx, p2, n2);
+	}
+
+	// 1 node contains the other one, their parents may overlap
+	for (uint32_t a = 0; a < n2; ++a)
+	{
+		bool found = false;
+		for (uint32_t b = 0; found == false && b < n1; ++b)
 		{
-			prevOnes = prevLayer->vals[i]->numOnes;
-			boundaries[prevOnes] = i;
+			found = (p1[b] == p2[a]);
+		}
+		if (found == false && McCluskeyVals_addParents(layer, idx, &p2[a], 1) == false)
+		{
+			return false;
 		}
 	}
+	return true;
+}
+///
+///	@brief Copies a node with its parents to destination layer, unless the
+///	destination layer already contains it
+///	@returns Whether the operation was successful
+///
+static inline bool solveLayer_pushFromUnique_impl(
+	McCluskeyVals_t * restrict layer,
+	const McCluskeyVals_t * restrict src,
+	size_t idx
+)
+{
+	McCluskeyVal_t val;
+	McCluskeyVals_get(src, idx, &val);
 
-	bool * hasConnected = calloc(prevLayer->n_vals, sizeof(bool));
-	if (hasConnected == NULL)
+	bool inserted;
+	if (McCluskeyVals_pushUnique(layer, &val, &inserted) == false)
 	{
-		// Remove layer
-		McCluskeySolver_popLayer(This);
 		return false;
 	}
+	else if (inserted == false)
+	{
+		return true;
+	}
 
-	for (uint8_t i = 0; i < prevOnes; ++i)
+	uint32_t n_parents;
+	const uint32_t * parents = McCluskeyVals_getParents(src, idx, &n_parents);
+	return McCluskeyVals_addParents(layer, layer->n_vals - 1, parents, n_parents);
+}
+
+///
+///	@brief Finds group boundaries of a layer sorted by the number of ones, group with
+///	g ones spans [boundaries[g], boundaries[g + 1])
+///	@param prevLayer Source layer
+///	@param boundaries Array receiving the boundaries
+///	@returns Largest number of ones in the layer
+///
+static inline uint8_t solveLayer_boundaries_impl(
+	const McCluskeyVals_t * restrict prevLayer,
+	size_t * restrict boundaries
+)
+{
+	uint8_t prevOnes = 0;
+	boundaries[0] = 0;
+	for (size_t i = 0; i < prevLayer->n_vals; ++i)
 	{
-		size_t b1 = boundaries[i], b2 = boundaries[i+1];
-		if ((prevLayer->vals[b1]->numOnes + 1) !=  prevLayer->vals[b2]->numOnes)
+		while (prevOnes < prevLayer->numOnes[i])
 		{
-			continue;
+			++prevOnes;
+			boundaries[prevOnes] = i;
 		}
-		for (size_t j = b1; j < b2; ++j)
+	}
+	for (size_t i = (size_t)prevOnes + 1; i < (MCCLUSKEYVAL_MAX_ARGVEC + 2); ++i)
+	{
+		boundaries[i] = prevLayer->n_vals;
+	}
+
+	return prevOnes;
+}
+///
+///	@returns Mask of all variables used by the nodes of a layer
+///
+static inline McCluskeyMask_t solveLayer_varMask_impl(const McCluskeyVals_t * restrict prevLayer)
+{
+	uint8_t maxLen = 0;
+	for (size_t j = 0; j < prevLayer->n_vals; ++j)
+	{
+		maxLen = (prevLayer->lens[j] > maxLen) ? prevLayer->lens[j] : maxLen;
+	}
+	return (maxLen >= MCCLUSKEYVAL_MAX_ARGVEC) ?
+		(McCluskeyMask_t)~(McCluskeyMask_t)0 : (((McCluskeyMask_t)1 << maxLen) - 1);
+}
+
+///
+///	@brief Number of rows/columns of a tile of the pair scan, a tile of both groups
+///	fits into L1 cache
+///
+#define MCCLUSKEY_TILE_ROWS 512
+#define MCCLUSKEY_TILE_COLS 2048
+
+///
+///	@brief Finds all mergeable pairs of a tile row range [jt, jtEnd) against the
+///	nodes [k0, k1). Columns are scanned tile by tile for cache locality, the pairs
+///	are then ordered by row so that merging happens in the same order as with an
+///	untiled scan
+///	@param pairs Pointer to pair buffer, pairs are stored as (row << 32) | k
+///	@param sorted Pointer to buffer receiving pairs ordered by row
+///	@param cap_pairs Pointer to capacity of both buffers
+///	@param n_pairs Pointer receiving number of pairs
+///	@returns Whether the operation was successful
+///
+static inline bool solveLayer_pairScanTile_impl(
+	const McCluskeyVals_t * restrict prevLayer,
+	McCluskeyScanKernel_t kernel,
+	size_t jt,
+	size_t jtEnd,
+	size_t k0,
+	size_t k1,
+	uint64_t * restrict * restrict pairs,
+	uint64_t * restrict * restrict sorted,
+	size_t * restrict cap_pairs,
+	size_t * restrict n_pairs
+)
+{
+	uint32_t matches[MCCLUSKEY_TILE_COLS];
+	size_t rowStart[MCCLUSKEY_TILE_ROWS + 1] = { 0 };
+
+	size_t n = 0;
+	for (size_t kt = k0; kt < k1; kt += MCCLUSKEY_TILE_COLS)
+	{
+		const size_t n_cols = ((k1 - kt) > MCCLUSKEY_TILE_COLS) ? MCCLUSKEY_TILE_COLS : (k1 - kt);
+		for (size_t j = jt; j < jtEnd; ++j)
 		{
-			uint8_t baseOnes = prevLayer->vals[b2]->numOnes;
-			for (size_t k = b2; k < prevLayer->n_vals; ++k)
+			// Find all nodes differing in at most 1 variable
+			const size_t n_matches = kernel(
+				prevLayer->ones[j], prevLayer->dashes[j],
+				&prevLayer->ones[kt], &prevLayer->dashes[kt],
+				n_cols, matches
+			);
+			if ((n + n_matches) > *cap_pairs)
 			{
-				if (prevLayer->vals[k]->numOnes != baseOnes)
-				{
-					break;
-				}
-				// Start fiddling
+				const size_t newcap = (n + n_matches) * 2;
+				MCCLUSKEY_REALLOC_ARR(prevLayer->ctx, *pairs,  newcap);
+				MCCLUSKEY_REALLOC_ARR(prevLayer->ctx, *sorted, newcap);
+				*cap_pairs = newcap;
+			}
+			for (size_t m = 0; m < n_matches; ++m)
+			{
+				(*pairs)[n] = ((uint64_t)(j - jt) << 32) | (uint64_t)(kt + matches[m]);
+				++n;
+			}
+			rowStart[j - jt + 1] += n_matches;
+		}
+	}
+
+	// Stable counting sort by row, columns of a row stay ascending
+	for (size_t i = 1; i <= MCCLUSKEY_TILE_ROWS; ++i)
+	{
+		rowStart[i] += rowStart[i - 1];
+	}
+	for (size_t i = 0; i < n; ++i)
+	{
+		(*sorted)[rowStart[(*pairs)[i] >> 32]++] = (*pairs)[i];
+	}
+
+	*n_pairs = n;
+	return true;
+}
+///
+///	@brief Merges all mergeable pairs of nodes j in [j0, j1) and k in [k0, k1) by
+///	comparing every node of the first range with every node of the second range.
+///	The ranges are processed in cache-sized tiles
+///	@param layer Destination layer
+///	@param since Index of destination layer from which on duplicates are checked
+///	@param prevLayer Source layer
+///	@param hasConnected Bitset receiving nodes of source layer that were merged
+///	@param stats Pointer to counters of comparisons and merges
+///	@param kernel Comparison kernel
+///	@returns Whether the operation was successful
+///
+static inline bool solveLayer_pairScanRange_impl(
+	McCluskeyVals_t * restrict layer,
+	size_t since,
+	const McCluskeyVals_t * restrict prevLayer,
+	uint64_t * restrict hasConnected,
+	McCluskeyStats_t * restrict stats,
+	McCluskeyScanKernel_t kernel,
+	size_t j0,
+	size_t j1,
+	size_t k0,
+	size_t k1
+)
+{
+	uint64_t * pairs = NULL, * sorted = NULL;
+	size_t cap_pairs = 0;
+	MCCLUSKEY_STAT(stats->comparisons += (uint64_t)(j1 - j0) * (uint64_t)(k1 - k0));
+	MCCLUSKEY_STAT(stats->kernel = McCluskeyScan_getKernelName());
+
+	bool success = true;
+	for (size_t jt = j0; success && jt < j1; jt += MCCLUSKEY_TILE_ROWS)
+	{
+		const size_t jtEnd = ((j1 - jt) > MCCLUSKEY_TILE_ROWS) ? (jt + MCCLUSKEY_TILE_ROWS) : j1;
+		size_t n_pairs = 0;
+		success = solveLayer_pairScanTile_impl(
+			prevLayer, kernel, jt, jtEnd, k0, k1,
+			&pairs, &sorted, &cap_pairs, &n_pairs
+		);
+		for (size_t i = 0; success && i < n_pairs; ++i)
+		{
+			const size_t j = jt + (size_t)(sorted[i] >> 32), k = (size_t)(sorted[i] & UINT32_MAX);
+			success = solveLayer_pushMerged_impl(layer, since, prevLayer, hasConnected, stats, j, k);
+		}
+	}
 
-				McCluskeyVal_t newVec;
-				if (McCluskeyVal_merge(&newVec, prevLayer->vals[j], prevLayer->vals[k]) == true)
+	McCluskeyCtx_free(prevLayer->ctx, pairs);
+	McCluskeyCtx_free(prevLayer->ctx, sorted);
+	return success;
+}
+///
+///	@brief Merges all nodes j in [j0, j1) with their partners by looking up the only
+///	possible partners of every node from the source layer's hash index. A partner of
+///	a node has 1 more one and differs in exactly 1 variable: either a '0' of the node
+///	becomes '1' with the same dash positions, or a '-' of the node becomes '1'
+///	@param layer Destination layer
+///	@param since Index of destination layer from which on duplicates are checked
+///	@param prevLayer Source layer, has to be indexed
+///	@param hasConnected Bitset receiving nodes of source layer that were merged
+///	@param stats Pointer to counters of lookups and merges
+///	@param varMask Mask of variables used by the source layer
+///	@returns Whether the operation was successful
+///
+static inline bool solveLayer_lookupRange_impl(
+	McCluskeyVals_t * restrict layer,
+	size_t since,
+	const McCluskeyVals_t * restrict prevLayer,
+	uint64_t * restrict hasConnected,
+	McCluskeyStats_t * restrict stats,
+	McCluskeyMask_t varMask,
+	size_t j0,
+	size_t j1
+)
+{
+	for (size_t j = j0; j < j1; ++j)
+	{
+		const McCluskeyMask_t ones = prevLayer->ones[j], dashes = prevLayer->dashes[j];
+		McCluskeyMask_t freeVars = varMask & ~ones;
+		MCCLUSKEY_STAT(stats->comparisons += McCluskeyMask_popcount(freeVars));
+		while (freeVars != 0)
+		{
+			const McCluskeyMask_t bit = freeVars & (~freeVars + 1);
+			freeVars ^= bit;
+
+			const size_t k = McCluskeyVals_find(prevLayer, ones | bit, dashes & ~bit);
+			if (k == MCCLUSKEYVALS_NOT_FOUND)
+			{
+				continue;
+			}
+
+			if (solveLayer_pushMerged_impl(layer, since, prevLayer, hasConnected, stats, j, k) == false)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+///
+///	@brief Number of node comparisons/lookups a parallel task is sized to
+///
+#define MCCLUSKEY_TASK_COST (1 << 16)
+
+///
+///	@brief Output range of a parallel task in its worker's buffer
+///
+typedef struct McCluskeyLayerSegment
+{
+	size_t worker, begin, end;
+
+} McCluskeyLayerSegment_t;
+
+///
+///	@brief Shared state of parallel layer generation
+///
+typedef struct McCluskeyLayerJob
+{
+	const McCluskeyVals_t * prevLayer;
+	McCluskeyPrimeMode_t primeMode;
+	McCluskeyMask_t varMask;
+	McCluskeyScanKernel_t kernel;
+	size_t boundaries[MCCLUSKEYVAL_MAX_ARGVEC + 2];
+
+	// Thread-local output buffers, connection bitsets and counters
+	McCluskeyVals_t * buffers;
+	uint64_t ** connected;
+	McCluskeyStats_t * stats;
+	McCluskeyLayerSegment_t * segments;
+
+} McCluskeyLayerJob_t;
+
+///
+///	@brief Work function of parallel layer generation, task arguments are: task
+///	index, start and end of source node range, group index for pair scan
+///
+static bool solveLayer_task_impl(MCPool_t * pool, size_t worker, const MCPoolTask_t * task, void * user)
+{
+	(void)pool;
+	McCluskeyLayerJob_t * job = user;
+	McCluskeyVals_t * buffer  = &job->buffers[worker];
+	const size_t begin = buffer->n_vals;
+
+	bool success;
+	if (job->primeMode == McCluskeyPrimeMode_lookup)
+	{
+		success = solveLayer_lookupRange_impl(
+			buffer, begin, job->prevLayer, job->connected[worker], &job->stats[worker], job->varMask,
+			task->args[1], task->args[2]
+		);
+	}
+	else
+	{
+		const size_t g = task->args[3];
+		success = solveLayer_pairScanRange_impl(
+			buffer, begin, job->prevLayer, job->connected[worker], &job->stats[worker], job->kernel,
+			task->args[1], task->args[2], job->boundaries[g + 1], job->boundaries[g + 2]
+		);
+	}
+
+	job->segments[task->args[0]] = (McCluskeyLayerSegment_t){
+		.worker = worker,
+		.begin  = begin,
+		.end    = buffer->n_vals
+	};
+	return success;
+}
+///
+///	@brief Splits source layer into tasks
+///	@param job Pointer to job state
+///	@param tasks Pointer to variable receiving the task array
+///	@returns Number of tasks, SIZE_MAX on failure
+///
+static inline size_t solveLayer_makeTasks_impl(const McCluskeyLayerJob_t * restrict job, MCPoolTask_t ** restrict tasks)
+{
+	size_t n_tasks = 0, cap_tasks = 0;
+	*tasks = NULL;
+
+	const size_t n_groups = (job->primeMode == McCluskeyPrimeMode_lookup) ? 1 : MCCLUSKEYVAL_MAX_ARGVEC;
+	for (size_t g = 0; g < n_groups; ++g)
+	{
+		size_t j0, j1, chunk;
+		if (job->primeMode == McCluskeyPrimeMode_lookup)
+		{
+			j0 = 0;
+			j1 = job->prevLayer->n_vals;
+			chunk = MCCLUSKEY_TASK_COST / MCCLUSKEYVAL_MAX_ARGVEC;
+		}
+		else
+		{
+			// Tile large group pairs by rows of the first group
+			j0 = job->boundaries[g];
+			j1 = job->boundaries[g + 1];
+			const size_t cols = job->boundaries[g + 2] - job->boundaries[g + 1];
+			if (cols == 0)
+			{
+				continue;
+			}
+			chunk = (cols >= MCCLUSKEY_TASK_COST) ? 1 : (MCCLUSKEY_TASK_COST / cols);
+		}
+
+		for (size_t j = j0; j < j1; j += chunk)
+		{
+			if (n_tasks >= cap_tasks)
+			{
+				size_t newcap = (n_tasks + 1) * 2;
+				MCPoolTask_t * newmem = realloc(*tasks, sizeof(MCPoolTask_t) * newcap);
+				if (newmem == NULL)
 				{
-					if (McCluskeyVals_push(layer, &newVec) == false)
-					{
-						// Adding member failed
-						free(hasConnected);
-						// Remove layer
-						McCluskeySolver_popLayer(This);
-
-						return false;
-					}
-					hasConnected[j] = true;
-					hasConnected[k] = true;
+					free(*tasks);
+					*tasks = NULL;
+					return SIZE_MAX;
 				}
+				*tasks    = newmem;
+				cap_tasks = newcap;
+			}
+			(*tasks)[n_tasks] = (MCPoolTask_t){ .args = {
+				n_tasks,
+				j,
+				((j1 - j) > chunk) ? (j + chunk) : j1,
+				g
+			} };
+			++n_tasks;
+		}
+	}
+
+	return n_tasks;
+}
+///
+///	@brief Finds all mergeable pairs using a pool of worker threads. Results are
+///	merged in task order, so the resulting layer is identical to the single-threaded
+///	result
+///	@param This Pointer to the solver object
+///	@param layer Destination layer
+///	@param prevLayer Source layer, has to be indexed for lookup mode
+///	@param hasConnected Bitset receiving nodes of source layer that were merged
+///	@param stats Pointer to counters receiving the sums of all threads
+///	@returns Whether the operation was successful
+///
+static inline bool solveLayer_parallel_impl(
+	const McCluskeySolver_t * restrict This,
+	McCluskeyVals_t * restrict layer,
+	const McCluskeyVals_t * restrict prevLayer,
+	uint64_t * restrict hasConnected,
+	McCluskeyStats_t * restrict stats
+)
+{
+	const size_t n_words = (prevLayer->n_vals + 63) / 64;
+
+	McCluskeyLayerJob_t job = {
+		.prevLayer = prevLayer,
+		.primeMode = This->ctx->primeMode,
+		.varMask   = solveLayer_varMask_impl(prevLayer),
+		.kernel    = McCluskeyScan_getKernel()
+	};
+	solveLayer_boundaries_impl(prevLayer, job.boundaries);
+
+	MCPoolTask_t * tasks = NULL;
+	const size_t n_tasks = solveLayer_makeTasks_impl(&job, &tasks);
+	if (n_tasks == SIZE_MAX)
+	{
+		return false;
+	}
+
+	// Workers beyond the number of tasks would stay idle
+	size_t n_threads = (This->ctx->n_threads == 0) ? MCPool_hardwareThreads() : This->ctx->n_threads;
+	n_threads = (n_threads < n_tasks) ? n_threads : n_tasks;
+	n_threads = (n_threads > 0) ? n_threads : 1;
+
+	job.buffers   = calloc(n_threads, sizeof(McCluskeyVals_t));
+	job.connected = calloc(n_threads, sizeof(uint64_t *));
+	job.stats     = calloc(n_threads, sizeof(McCluskeyStats_t));
+	job.segments  = malloc(sizeof(McCluskeyLayerSegment_t) * (n_tasks + 1));
+
+	bool success = (job.buffers != NULL) && (job.connected != NULL) && (job.stats != NULL) && (job.segments != NULL);
+	size_t n_made = 0;
+	for (; success && n_made < n_threads; ++n_made)
+	{
+		McCluskeyVals_make(&job.buffers[n_made], This->ctx);
+		job.connected[n_made] = calloc(n_words + 1, sizeof(uint64_t));
+		success = (job.connected[n_made] != NULL);
+	}
+
+	success = success && MCPool_run(n_threads, tasks, n_tasks, &solveLayer_task_impl, &job);
+
+	// Merge thread-local results in task order
+	for (size_t t = 0; success && t < n_tasks; ++t)
+	{
+		const McCluskeyLayerSegment_t * seg = &job.segments[t];
+		for (size_t i = seg->begin; success && i < seg->end; ++i)
+		{
+			success = solveLayer_pushFromUnique_impl(layer, &job.buffers[seg->worker], i);
+		}
+	}
+	for (size_t i = 0; success && i < n_threads; ++i)
+	{
+		for (size_t w = 0; w < n_words; ++w)
+		{
+			hasConnected[w] |= job.connected[i][w];
+		}
+		MCCLUSKEY_STAT(stats->comparisons += job.stats[i].comparisons);
+		MCCLUSKEY_STAT(stats->merges      += job.stats[i].merges);
+		MCCLUSKEY_STAT(stats->duplicates  += job.stats[i].duplicates);
+		MCCLUSKEY_STAT(stats->kernel = (job.stats[i].kernel != NULL) ? job.stats[i].kernel : stats->kernel);
+	}
+
+	for (size_t i = 0; i < n_made; ++i)
+	{
+		McCluskeyVals_destroy(&job.buffers[i]);
+		free(job.connected[i]);
+	}
+	free(job.buffers);
+	free(job.connected);
+	free(job.stats);
+	free(job.segments);
+	free(tasks);
+
+	return success;
+}
+
+///
+///	@brief Clears the solver's connection bitset, growing it to hold n_words words
+///	@returns Pointer to the bitset, NULL on failure
+///
+static inline uint64_t * solveLayer_connected_impl(McCluskeySolver_t * restrict This, size_t n_words)
+{
+	if (n_words > This->cap_connected)
+	{
+		uint64_t * newmem = McCluskeyCtx_realloc(This->ctx, This->connected, sizeof(uint64_t) * n_words);
+		if (newmem == NULL)
+		{
+			return NULL;
+		}
+		This->connected     = newmem;
+		This->cap_connected = n_words;
+	}
+	if (This->connected != NULL)
+	{
+		memset(This->connected, 0, sizeof(uint64_t) * n_words);
+	}
+	return This->connected;
+}
+bool McCluskeySolver_solveLayer(McCluskeySolver_t * restrict This, bool * restrict newNodes)
+{
+	*newNodes = false;
+	if (This->ctx->engine == McCluskeyEngine_espresso)
+	{
+		return true;
+	}
+	else if (McCluskeySolver_getLayer(This) == NULL || McCluskeySolver_pushLayer(This) == false)
+	{
+		return false;
+	}
+	McCluskeyVals_t * layer = McCluskeySolver_getLayer(This);
+	McCluskeyVals_t * prevLayer = layer - 1;
+
+	// 1 extra word, so that empty layers allocate too
+	uint64_t * hasConnected = solveLayer_connected_impl(This, (prevLayer->n_vals + 63) / 64 + 1);
+	if (hasConnected == NULL ||
+		(This->ctx->primeMode == McCluskeyPrimeMode_lookup && prevLayer->index == NULL &&
+			McCluskeyVals_buildIndex(prevLayer) == false)
+	)
+	{
+		// Remove layer
+		McCluskeySolver_popLayer(This);
+		return false;
+	}
+
+	bool success = true;
+	if (This->ctx->n_threads != 1)
+	{
+		success = solveLayer_parallel_impl(This, layer, prevLayer, hasConnected, &This->stats);
+	}
+	else if (This->ctx->primeMode == McCluskeyPrimeMode_lookup)
+	{
+		success = solveLayer_lookupRange_impl(
+			layer, 0, prevLayer, hasConnected, &This->stats, solveLayer_varMask_impl(prevLayer), 0, prevLayer->n_vals
+		);
+	}
+	else
+	{
+		size_t boundaries[MCCLUSKEYVAL_MAX_ARGVEC + 2];
+		const uint8_t prevOnes = solveLayer_boundaries_impl(prevLayer, boundaries);
+		const McCluskeyScanKernel_t kernel = McCluskeyScan_getKernel();
+		for (uint8_t i = 0; success && i < prevOnes; ++i)
+		{
+			success = solveLayer_pairScanRange_impl(
+				layer, 0, prevLayer, hasConnected, &This->stats, kernel,
+				boundaries[i], boundaries[i + 1], boundaries[i + 1], boundaries[i + 2]
+			);
+		}
+	}
+	if (success == false)
+	{
+		// Adding member failed
+		// Remove layer
+		McCluskeySolver_popLayer(This);
+
+		return false;
+	}
+
+	// Nodes of different outputs and nodes containing each other stay unconnected
+	// and merge again in every layer, the layer is only new if merging produced a
+	// node not seen before
+	if (layer->n_vals > 0 && prevLayer->index == NULL && McCluskeyVals_buildIndex(prevLayer) == false)
+	{
+		McCluskeySolver_popLayer(This);
+		return false;
+	}
+	size_t n_fresh = 0;
+	for (size_t i = 0; i < layer->n_vals; ++i)
+	{
+		n_fresh += (McCluskeyVals_find(prevLayer, layer->ones[i], layer->dashes[i]) == MCCLUSKEYVALS_NOT_FOUND);
+	}
+	This->info[This->n_set - 1].n_fresh = n_fresh;
+
+	// Sort out all elements that have been left out unconnected
+	// (by using bitset hasConnected)
+	for (size_t i = 0; i < prevLayer->n_vals; ++i)
+	{
+		if (McCluskey_bitsetGet(hasConnected, i) == false &&
+			solveLayer_pushFromUnique_impl(layer, prevLayer, i) == false
+		)
+		{
+			// Remove layer
+			McCluskeySolver_popLayer(This);
+			return false;
+		}
+	}
+
+	// Sort new data, memory of the layers is kept for the following layers and problems
+	if (McCluskeyVals_sortWith(layer, &This->scratch) == false)
+	{
+		McCluskeySolver_popLayer(This);
+		return false;
+	}
+
+	// Nodes of the previous layer have been merged or carried over, so the new layer
+	// holds all prime implicants found so far. The new layer takes the place of the
+	// previous one, whose memory is reused by the next layer
+	if (This->ctx->lowMemory && This->n_set > 2)
+	{
+		MCCLUSKEY_SWAP(This->set[This->n_set - 2],  This->set[This->n_set - 1]);
+		MCCLUSKEY_SWAP(This->info[This->n_set - 2], This->info[This->n_set - 1]);
+		McCluskeySolver_popLayer(This);
+		This->layered = false;
+	}
+
+	*newNodes = n_fresh > 0;
+	return true;
+}
+
+///
+///	@brief Minimises the input layer with the Espresso-style engine into 1 new layer
+///	@returns Whether the operation was successful
+///
+static inline bool optimiseLayer_espresso_impl(McCluskeySolver_t * restrict This, size_t * restrict newLayers)
+{
+	if (McCluskeySolver_getBaseLayer(This) == NULL || McCluskeySolver_pushLayer(This) == false)
+	{
+		return false;
+	}
+	if (McCluskeyEspresso_minimise(McCluskeySolver_getBaseLayer(This), McCluskeySolver_getLayer(This)) == false)
+	{
+		McCluskeySolver_popLayer(This);
+		return false;
+	}
+	*newLayers = 1;
+	return true;
+}
+///
+///	@brief Bounds the cover search by the primes of a previous cover that are still
+///	prime implicants, completed greedily to a cover
+///	@param primes Prime implicants of the cover problem
+///	@param prevCover Previous cover
+///	@returns Whether the operation was successful
+///
+static inline bool optimiseLayer_warmStart_impl(
+	McCluskeyCover_t * restrict cover,
+	McCluskeyVals_t * restrict primes,
+	const McCluskeyVals_t * restrict prevCover
+)
+{
+	if (primes->index == NULL && McCluskeyVals_buildIndex(primes) == false)
+	{
+		return false;
+	}
+	uint32_t * kept = McCluskeyCtx_realloc(primes->ctx, NULL, sizeof(uint32_t) * (prevCover->n_vals + 1));
+	if (kept == NULL)
+	{
+		return false;
+	}
+
+	size_t n_kept = 0;
+	for (size_t i = 0; i < prevCover->n_vals; ++i)
+	{
+		const size_t idx = McCluskeyVals_find(primes, prevCover->ones[i], prevCover->dashes[i]);
+		if (idx != MCCLUSKEYVALS_NOT_FOUND)
+		{
+			kept[n_kept] = (uint32_t)idx;
+			++n_kept;
+		}
+	}
+
+	const bool success = McCluskeyCover_warmStart(cover, kept, n_kept);
+	McCluskeyCtx_free(primes->ctx, kept);
+	return success;
+}
+///
+///	@brief Optimises the current layer
+///	@param prevCover Previous cover to start the search from, NULL if none
+///	@returns Whether the operation was successful
+///
+static inline bool optimiseLayer_impl(
+	McCluskeySolver_t * restrict This,
+	const McCluskeyVals_t * restrict prevCover,
+	size_t * restrict newLayers
+)
+{
+	*newLayers = 0;
+	This->stats.n_primes    = 0;
+	This->stats.n_essential = 0;
+	This->stats.coverNodes  = 0;
+	This->stats.coversFound = 0;
+	This->expired = false;
+	if (This->ctx->engine == McCluskeyEngine_espresso)
+	{
+		return optimiseLayer_espresso_impl(This, newLayers);
+	}
+
+	const McCluskeyVals_t * prevLayer = McCluskeySolver_getLayer(This);
+	if (prevLayer == NULL)
+	{
+		return false;
+	}
+
+	// Prime implicants are gathered to the scratch array
+	McCluskeyVals_t * baseLayer = &This->scratch;
+	McCluskeyVals_clear(baseLayer);
+	for (size_t i = 0; i < prevLayer->n_vals; ++i)
+	{
+		if (prevLayer->states[i] == McCluskeyState_one &&
+			McCluskeyVals_pushFrom(baseLayer, prevLayer, i) == false
+		)
+		{
+			return false;
+		}
+	}
+
+	MCCLUSKEY_STAT(This->stats.n_primes = baseLayer->n_vals);
+
+	// All totally unnecessary items eliminated, already sorted array
+	if (baseLayer->n_vals < 2)
+	{
+		if (McCluskeySolver_pushLayer(This) == false)
+		{
+			return false;
+		}
+		MCCLUSKEY_SWAP(*McCluskeySolver_getLayer(This), *baseLayer);
+		*newLayers = 1;
+		return true;
+	}
+
+	// Search all minimum covers of minterms by prime implicants
+	McCluskeyCover_t cover;
+	if (McCluskeyCover_make(&cover, baseLayer, McCluskeySolver_getBaseLayer(This)) == false)
+	{
+		return false;
+	}
+	// A budgeted search starts from a greedy cover, so that it always has one
+	const bool budget = (This->ctx->timeBudget > 0.0) || (This->ctx->nodeBudget > 0);
+	McCluskeyCover_setBudget(&cover, This->ctx->timeBudget, This->ctx->nodeBudget);
+	bool success = (prevCover == NULL || prevCover->n_vals == 0 ||
+		optimiseLayer_warmStart_impl(&cover, baseLayer, prevCover)) &&
+		(!budget || McCluskeyCover_warmStart(&cover, NULL, 0)) &&
+		McCluskeyCover_solve(&cover, This->ctx->n_threads);
+	This->expired = !McCluskeyCover_isOptimal(&cover);
+
+	MCCLUSKEY_STAT(This->stats.n_essential = McCluskeyCover_getEssentialCount(&cover));
+	MCCLUSKEY_STAT(This->stats.coverNodes  = cover.n_visited);
+	MCCLUSKEY_STAT(This->stats.coversFound = cover.n_recorded);
+
+	const size_t n_covers = McCluskeyCover_getCount(&cover), coverSize = McCluskeyCover_getSize(&cover);
+	for (size_t i = 0; success && i < n_covers; ++i)
+	{
+		success = McCluskeySolver_pushLayer(This);
+		if (success)
+		{
+			++*newLayers;
+			McCluskeyVals_t * layer = McCluskeySolver_getLayer(This);
+			const uint32_t * solution = McCluskeyCover_getSolution(&cover, i);
+			for (size_t j = 0; success && j < coverSize; ++j)
+			{
+				success = McCluskeyVals_pushFrom(layer, baseLayer, solution[j]);
 			}
 		}
 	}
+	if (!success)
+	{
+		// Remove partial results
+		for (; *newLayers > 0; --*newLayers)
+		{
+			McCluskeySolver_popLayer(This);
+		}
+	}
+
+	McCluskeyCover_destroy(&cover);
+
+	return success;
+}
+bool McCluskeySolver_optimiseLayer(McCluskeySolver_t * restrict This, size_t * restrict newLayers)
+{
+	const bool success = optimiseLayer_impl(This, NULL, newLayers);
+	This->n_covers = *newLayers;
+	return success;
+}
+bool McCluskeySolver_isExpired(const McCluskeySolver_t * restrict This)
+{
+	return This->expired;
+}
+///
+///	@brief Prepares the first layer for edits on the first edit after a reset. Rows
+///	are found through the index of the first layer, duplicate rows are merged. The
+///	other layers then refer to the old row indices and are dropped to be solved again
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeySolver_prepareEdit_impl(McCluskeySolver_t * restrict This)
+{
+	McCluskeyVals_t * base = McCluskeySolver_getBaseLayer(This);
+	if (base == NULL)
+	{
+		return false;
+	}
+	else if (This->editable)
+	{
+		return true;
+	}
+	else if (base->index == NULL && McCluskeyVals_buildIndex(base) == false)
+	{
+		return false;
+	}
+
+	bool duplicates = false;
+	for (size_t i = 0; duplicates == false && i < base->n_vals; ++i)
+	{
+		duplicates = (McCluskeyVals_find(base, base->ones[i], base->dashes[i]) != i);
+	}
+	if (duplicates)
+	{
+		while (This->n_set > 1)
+		{
+			McCluskeySolver_popLayer(This);
+		}
+		This->n_covers = 0;
+		const size_t n_rows = base->n_vals;
+		if (McCluskeyVals_removeDuplicates(base) == false)
+		{
+			return false;
+		}
+		MCCLUSKEY_STAT(This->stats.duplicateRows += n_rows - base->n_vals);
+		base->n_parents = 0;
+		memset(base->parentCnt, 0, sizeof(uint32_t) * base->n_vals);
+		if (McCluskeySolver_selfParents_impl(base) == false)
+		{
+			return false;
+		}
+	}
+
+	McCluskeyVals_clear(&This->edits);
+	This->editable = true;
+	return true;
+}
+///
+///	@brief Finds the row of the first layer with the argument vector of a node and
+///	records its outputs before the first edit since the last update
+///	@param val Pointer to node
+///	@param idx Pointer to variable receiving the index of the row,
+///	MCCLUSKEYVALS_NOT_FOUND if there is none
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeySolver_recordEdit_impl(
+	McCluskeySolver_t * restrict This,
+	const McCluskeyVal_t * restrict val,
+	size_t * restrict idx
+)
+{
+	if (McCluskeySolver_prepareEdit_impl(This) == false)
+	{
+		return false;
+	}
+	const McCluskeyVals_t * base = McCluskeySolver_getBaseLayer(This);
+	*idx = McCluskeyVals_find(base, val->ones, val->dashes);
+
+	McCluskeyVals_t * edits = &This->edits;
+	if (edits->index == NULL && McCluskeyVals_buildIndex(edits) == false)
+	{
+		return false;
+	}
+	else if (McCluskeyVals_find(edits, val->ones, val->dashes) != MCCLUSKEYVALS_NOT_FOUND)
+	{
+		return true;
+	}
+
+	McCluskeyVal_t old = *val;
+	if (*idx != MCCLUSKEYVALS_NOT_FOUND)
+	{
+		McCluskeyVals_get(base, *idx, &old);
+	}
+	else
+	{
+		old.onTag = 0;
+		old.dcTag = 0;
+		old.state = McCluskeyState_undefined;
+	}
+	return McCluskeyVals_push(edits, &old);
+}
+///
+///	@brief Updates the parent reference of an edited row, a defined row is its own
+///	parent. The slot of an earlier parent reference of the row is reused
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeySolver_rowParents_impl(McCluskeyVals_t * restrict base, size_t idx)
+{
+	const uint32_t self = (uint32_t)idx;
+	if (base->states[idx] == McCluskeyState_undefined)
+	{
+		base->parentCnt[idx] = 0;
+		return true;
+	}
+	else if (base->parentCnt[idx] > 0)
+	{
+		return true;
+	}
+	else if (base->parentOff[idx] < base->n_parents && base->parents[base->parentOff[idx]] == self)
+	{
+		base->parentCnt[idx] = 1;
+		return true;
+	}
+	return McCluskeyVals_addParents(base, idx, &self, 1);
+}
+bool McCluskeySolver_addRow(McCluskeySolver_t * restrict This, const McCluskeyVal_t * restrict val)
+{
+	size_t idx;
+	if (McCluskeySolver_recordEdit_impl(This, val, &idx) == false)
+	{
+		return false;
+	}
+
+	McCluskeyVals_t * base = McCluskeySolver_getBaseLayer(This);
+	if (idx == MCCLUSKEYVALS_NOT_FOUND)
+	{
+		if (McCluskeyVals_push(base, val) == false)
+		{
+			return false;
+		}
+		idx = base->n_vals - 1;
+	}
+	else
+	{
+		McCluskeyVals_addTags(base, idx, val->onTag, val->dcTag);
+		base->n_outputs = (val->n_outputs > base->n_outputs) ? val->n_outputs : base->n_outputs;
+	}
+
+	return McCluskeySolver_rowParents_impl(base, idx);
+}
+bool McCluskeySolver_removeRow(McCluskeySolver_t * restrict This, const McCluskeyVal_t * restrict val)
+{
+	size_t idx;
+	if (McCluskeySolver_recordEdit_impl(This, val, &idx) == false)
+	{
+		return false;
+	}
+	else if (idx == MCCLUSKEYVALS_NOT_FOUND)
+	{
+		return true;
+	}
+
+	McCluskeyVals_t * base = McCluskeySolver_getBaseLayer(This);
+	const McCluskeyTag_t tag = val->onTag | val->dcTag;
+	base->onTags[idx] &= ~tag;
+	base->dcTags[idx] &= ~tag;
+	base->states[idx]  = (base->onTags[idx] != 0) ? McCluskeyState_one : McCluskeyState_undefined;
+
+	return McCluskeySolver_rowParents_impl(base, idx);
+}
+
+///
+///	@brief Change of 1 node of a layer during an update
+///
+typedef struct McCluskeyChange
+{
+	McCluskeyMask_t ones, dashes;
+	// Whether the node existed before and after the change
+	bool before, after;
+
+} McCluskeyChange_t;
+
+///
+///	@brief Working memory of an update
+///
+typedef struct McCluskeyUpdate
+{
+	// Changes of the previous layer and the changes found in the current layer
+	McCluskeyChange_t * changes, * next;
+	size_t n_changes, n_next, cap_changes, cap_next;
+
+	// Parents of a recomputed node and sorted copies for comparison
+	uint32_t * parents, * sortedNew, * sortedOld;
+	size_t n_parents, cap_parents;
+
+	// Mask of all variables used by the first layer
+	McCluskeyMask_t varMask;
+
+	const McCluskeyCtx_t * ctx;
+
+} McCluskeyUpdate_t;
+
+///
+///	@brief Adds a change to the changes of the current layer
+///	@returns Whether the operation was successful
+///
+static inline bool update_pushChange_impl(
+	McCluskeyUpdate_t * restrict job,
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes,
+	bool before,
+	bool after
+)
+{
+	if (job->n_next >= job->cap_next)
+	{
+		const size_t newcap = (job->n_next + 1) * 2;
+		MCCLUSKEY_REALLOC_ARR(job->ctx, job->next, newcap);
+		job->cap_next = newcap;
+	}
+	job->next[job->n_next] = (McCluskeyChange_t){
+		.ones   = ones,
+		.dashes = dashes,
+		.before = before,
+		.after  = after
+	};
+	++job->n_next;
+	return true;
+}
+///
+///	@brief Appends parent references to the parents of the recomputed node, only the
+///	ones not present yet if dedup is set
+///	@returns Whether the operation was successful
+///
+static inline bool update_pushParents_impl(
+	McCluskeyUpdate_t * restrict job,
+	const uint32_t * restrict parents,
+	uint32_t n_parents,
+	bool dedup
+)
+{
+	if ((job->n_parents + n_parents) > job->cap_parents)
+	{
+		const size_t newcap = (job->n_parents + n_parents) * 2;
+		MCCLUSKEY_REALLOC_ARR(job->ctx, job->parents,   newcap);
+		MCCLUSKEY_REALLOC_ARR(job->ctx, job->sortedNew, newcap);
+		MCCLUSKEY_REALLOC_ARR(job->ctx, job->sortedOld, newcap);
+		job->cap_parents = newcap;
+	}
+
+	const size_t n_own = job->n_parents;
+	for (uint32_t a = 0; a < n_parents; ++a)
+	{
+		bool found = false;
+		for (size_t b = 0; dedup && found == false && b < n_own; ++b)
+		{
+			found = (job->parents[b] == parents[a]);
+		}
+		if (found == false)
+		{
+			job->parents[job->n_parents] = parents[a];
+			++job->n_parents;
+		}
+	}
+	return true;
+}
+///
+///	@returns Index of the node of a layer with given argument vector,
+///	MCCLUSKEYVALS_NOT_FOUND if there is none or it has no outputs
+///
+static inline size_t update_findLive_impl(const McCluskeyVals_t * restrict layer, McCluskeyMask_t ones, McCluskeyMask_t dashes)
+{
+	const size_t idx = McCluskeyVals_find(layer, ones, dashes);
+	return (idx == MCCLUSKEYVALS_NOT_FOUND || (layer->onTags[idx] | layer->dcTags[idx]) == 0) ?
+		MCCLUSKEYVALS_NOT_FOUND : idx;
+}
+///
+///	@returns Whether node a of a layer would be marked connected by solving the next
+///	layer, it merges with a partner into a node keeping all of its outputs
+///
+static inline bool update_isConnected_impl(const McCluskeyVals_t * restrict prevLayer, size_t a, McCluskeyMask_t varMask)
+{
+	const McCluskeyMask_t ones = prevLayer->ones[a], dashes = prevLayer->dashes[a];
+	const McCluskeyTag_t tagA = prevLayer->onTags[a] | prevLayer->dcTags[a];
+
+	// Partners with 1 more one: a '0' or a '-' becomes '1'
+	for (McCluskeyMask_t vars = varMask & ~ones; vars != 0; vars &= vars - 1)
+	{
+		const McCluskeyMask_t bit = vars & (~vars + 1);
+		const size_t k = update_findLive_impl(prevLayer, ones | bit, dashes & ~bit);
+		const McCluskeyTag_t tagK = (k == MCCLUSKEYVALS_NOT_FOUND) ? 0 : (prevLayer->onTags[k] | prevLayer->dcTags[k]);
+		if ((tagA & tagK) != 0 && (tagA & ~tagK) == 0)
+		{
+			return true;
+		}
+	}
+	// Partners with 1 less one: a '1' becomes '0' or '-'
+	for (McCluskeyMask_t vars = ones; vars != 0; vars &= vars - 1)
+	{
+		const McCluskeyMask_t bit = vars & (~vars + 1);
+		const size_t j0 = update_findLive_impl(prevLayer, ones & ~bit, dashes);
+		const size_t j1 = update_findLive_impl(prevLayer, ones & ~bit, dashes | bit);
+		const McCluskeyTag_t tag0 = (j0 == MCCLUSKEYVALS_NOT_FOUND) ? 0 : (prevLayer->onTags[j0] | prevLayer->dcTags[j0]);
+		const McCluskeyTag_t tag1 = (j1 == MCCLUSKEYVALS_NOT_FOUND) ? 0 : (prevLayer->onTags[j1] | prevLayer->dcTags[j1]);
+		if (((tagA & tag0) != 0 && (tagA & ~tag0) == 0) || ((tagA & tag1) != 0 && (tagA & ~tag1) == 0))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+///
+///	@brief Merges nodes j and k of the previous layer into the recomputed node if
+///	they are implicants of a common output, k has 1 more one than j. The parents
+///	are taken from the first merged pair
+///	@returns Whether the operation was successful
+///
+static inline bool update_mergePair_impl(
+	McCluskeyUpdate_t * restrict job,
+	const McCluskeyVals_t * restrict prevLayer,
+	size_t j,
+	size_t k,
+	McCluskeyVal_t * restrict val,
+	bool * restrict present
+)
+{
+	if (j == MCCLUSKEYVALS_NOT_FOUND || k == MCCLUSKEYVALS_NOT_FOUND)
+	{
+		return true;
+	}
+	const McCluskeyTag_t tagJ = prevLayer->onTags[j] | prevLayer->dcTags[j];
+	const McCluskeyTag_t tagK = prevLayer->onTags[k] | prevLayer->dcTags[k];
+	if ((tagJ & tagK) == 0)
+	{
+		return true;
+	}
+
+	const McCluskeyTag_t dcTag = prevLayer->dcTags[j] & prevLayer->dcTags[k];
+	val->onTag |= tagJ & tagK & ~dcTag;
+	val->dcTag |= dcTag;
+	val->len    = (prevLayer->lens[j] > val->len) ? prevLayer->lens[j] : val->len;
+	val->len    = (prevLayer->lens[k] > val->len) ? prevLayer->lens[k] : val->len;
+	if (*present)
+	{
+		return true;
+	}
+	*present = true;
+
+	uint32_t n1, n2;
+	const uint32_t * p1 = McCluskeyVals_getParents(prevLayer, j, &n1),
+	               * p2 = McCluskeyVals_getParents(prevLayer, k, &n2);
+	return update_pushParents_impl(job, p1, n1, false) &&
+		update_pushParents_impl(job, p2, n2, (prevLayer->dashes[j] ^ prevLayer->dashes[k]) != 0);
+}
+///
+///	@brief Computes the node with given argument vector as solving the previous layer
+///	would: merged from every pair of the previous layer it is the union of, with the
+///	outputs of the node itself added if it's in the previous layer unconnected
+///	@param val Pointer to node receiving the result
+///	@param present Pointer to variable receiving whether the node exists
+///	@returns Whether the operation was successful
+///
+static inline bool update_computeNode_impl(
+	McCluskeyUpdate_t * restrict job,
+	const McCluskeyVals_t * restrict prevLayer,
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes,
+	McCluskeyVal_t * restrict val,
+	bool * restrict present
+)
+{
+	*val = (McCluskeyVal_t){
+		.ones      = ones,
+		.dashes    = dashes,
+		.numOnes   = McCluskeyMask_popcount(ones),
+		.n_outputs = prevLayer->n_outputs
+	};
+	*present = false;
+	job->n_parents = 0;
+
+	const size_t self = update_findLive_impl(prevLayer, ones, dashes);
+	for (McCluskeyMask_t vars = dashes; vars != 0; vars &= vars - 1)
+	{
+		const McCluskeyMask_t bit = vars & (~vars + 1);
+		const size_t j = update_findLive_impl(prevLayer, ones, dashes & ~bit);
+		const size_t k = update_findLive_impl(prevLayer, ones | bit, dashes & ~bit);
+		if (update_mergePair_impl(job, prevLayer, j, k, val, present) == false ||
+			update_mergePair_impl(job, prevLayer, self, k, val, present) == false
+		)
+		{
+			return false;
+		}
+	}
 
-	bool ret = false;
-	// Sort out all elements that have been left out unconnected
-	// (by using array hasConnected)
-	for (size_t i = 0; i < prevLayer->n_vals; ++i)
+	if (self != MCCLUSKEYVALS_NOT_FOUND && update_isConnected_impl(prevLayer, self, job->varMask) == false)
 	{
-		if (hasConnected[i] == false)
+		val->onTag |= prevLayer->onTags[self];
+		val->dcTag |= prevLayer->dcTags[self];
+		val->len    = (prevLayer->lens[self] > val->len) ? prevLayer->lens[self] : val->len;
+		if (*present == false)
 		{
-			const McCluskeyVal_t * restrict current = prevLayer->vals[i];
-			McCluskeyVal_t * member;
-			if (McCluskeyVals_push(layer, current) == false ||
-				(	(member = McCluskeyVals_getLast(layer))->n_fromVec == 0 &&
-					member->state != McCluskeyState_undefined &&
-					McCluskeyVal_addParent(member, current) == false
-				)
-			)
+			*present = true;
+			uint32_t n_parents;
+			const uint32_t * parents = McCluskeyVals_getParents(prevLayer, self, &n_parents);
+			if (update_pushParents_impl(job, parents, n_parents, false) == false)
 			{
-				free(hasConnected);
-				// Remove layer
-				McCluskeySolver_popLayer(This);
 				return false;
 			}
 		}
-		else
-		{
-			ret = true;
-		}
 	}
 
-	free(hasConnected);
-
-	// Sort new data
-	McCluskeyVals_sort(layer);
-
-	// Remove duplicates
-	McCluskeyVals_removeDuplicates(layer);
-
-	McCluskeyVals_shrink(layer);
-
-	return ret;
+	val->dcTag &= ~val->onTag;
+	val->state  = (val->onTag != 0) ? McCluskeyState_one : McCluskeyState_undefined;
+	return true;
 }
-
 ///
-///	@brief Change interval parent count
-///	@param baseItem Pointer to interval object
-///	@param hashSet Pointer to hash-set
-///	@param deltaCount Amount by which the interval parent count would be changed
+///	@brief Orders parent references for comparison
 ///
-static inline void optimiseLayer_changeCount_impl(
-	const McCluskeyVal_t * restrict baseItem,
-	MCHashSet_t * restrict hashSet,
-	intptr_t deltaCount
-)
+static int McCluskey_cmpParents(const void * lhs, const void * rhs)
 {
-	for (size_t i = 0; i < baseItem->n_fromVec; ++i)
-	{
-		MCHashSetNode_t * node = MCHashSet_get(hashSet, baseItem->fromVec[i]->argVec);
-		if (deltaCount > 0)
-		{
-			*((uint32_t *)MCHashSetNode_getData(node)) += (uint32_t)deltaCount;
-		}
-		else
-		{
-			*((uint32_t *)MCHashSetNode_getData(node)) -= (uint32_t)(-deltaCount);
-		}
-	}
+	const uint32_t a = *(const uint32_t *)lhs, b = *(const uint32_t *)rhs;
+	return (a > b) - (a < b);
 }
 ///
-///	@brief Checks if set has "full house"
-///	@param arr Array to hash-set's interval nodes
-/// @param numElems Number of nodes
-///	@returns Whether set is complete
+///	@returns Whether node idx of a layer has the recomputed parents in any order
 ///
-static inline bool optimiseLayer_checkSet_impl(MCHashSetNode_t * const restrict * const restrict arr, size_t numElems)
+static inline bool update_sameParents_impl(McCluskeyUpdate_t * restrict job, const McCluskeyVals_t * restrict layer, size_t idx)
 {
-	for (size_t i = 0; i < numElems; ++i)
+	uint32_t n_parents;
+	const uint32_t * parents = McCluskeyVals_getParents(layer, idx, &n_parents);
+	if (n_parents != job->n_parents)
 	{
-		if (*((const uint32_t *)MCHashSetNode_getConstData(arr[i])) == 0)
-		{
-			return false;
-		}
+		return false;
 	}
-	return true;
+	else if (n_parents == 0 || memcmp(parents, job->parents, sizeof(uint32_t) * n_parents) == 0)
+	{
+		return true;
+	}
+
+	memcpy(job->sortedNew, job->parents, sizeof(uint32_t) * n_parents);
+	memcpy(job->sortedOld, parents,      sizeof(uint32_t) * n_parents);
+	qsort(job->sortedNew, n_parents, sizeof(uint32_t), &McCluskey_cmpParents);
+	qsort(job->sortedOld, n_parents, sizeof(uint32_t), &McCluskey_cmpParents);
+	return memcmp(job->sortedNew, job->sortedOld, sizeof(uint32_t) * n_parents) == 0;
 }
 ///
-///	@brief Recurse through all possibilities till the best variant is found
+///	@brief Recomputes the node of layer k with given argument vector from layer k - 1
+///	and records it as a change of layer k if it differs
+///	@returns Whether the operation was successful
 ///
-void optimiseLayer_recursiveVariations_impl(
-	size_t startDepth,
-	size_t startVal,
-	size_t * restrict maxDepth,
-	MCHashSet_t * restrict hashSet,
-	MCHashSetNode_t * const restrict * const restrict arr,
-	size_t * restrict indexArr,
-	size_t numElems,
+static inline bool update_node_impl(
 	McCluskeySolver_t * restrict This,
-	const McCluskeyVals_t * restrict baseLayer,
-	size_t * restrict newLayers
+	McCluskeyUpdate_t * restrict job,
+	size_t k,
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes
 )
 {
-	if (startDepth >= *maxDepth)
+	const McCluskeyVals_t * prevLayer = &This->set[k - 1];
+	McCluskeyVals_t * layer = &This->set[k];
+	McCluskeyLayerInfo_t * info = &This->info[k];
+
+	McCluskeyVal_t val;
+	bool present;
+	if (update_computeNode_impl(job, prevLayer, ones, dashes, &val, &present) == false)
 	{
-		return;
+		return false;
 	}
-	for (size_t i = startVal; i < baseLayer->n_vals; ++i)
-	{
-		// add something in respect to arr[startDepth] and i
-
-		indexArr[startDepth] = i;
-		optimiseLayer_changeCount_impl(
-			baseLayer->vals[i],
-			hashSet,
-			1
-		);
-
-		// check whole array
-		if (optimiseLayer_checkSet_impl(arr, numElems) == true)
-		{
-			if (*maxDepth != (startDepth + 1))
-			{
-				// Clear all previous layers
-				while (*newLayers > 0)
-				{
-					McCluskeyVals_destroyPreserveParents(McCluskeySolver_getLayer(This));
-					McCluskeySolver_popLayer(This);
-					--*newLayers;
-				}
-
-				*maxDepth = startDepth + 1;
-			}
-
-			// Add new "awesome" layer of size startDepth + 1
-			if (McCluskeySolver_pushLayer(This) == false)
-			{
-				exit(1);
-			}
-			McCluskeyVals_t * layer = McCluskeySolver_getLayer(This);
-
-			for (size_t j = 0, sz = startDepth + 1; j < sz; ++j)
-			{
-				// element is baseLayer->vals[indexArr[j]]
-
-				if (McCluskeyVals_push(layer, baseLayer->vals[indexArr[j]]) == false)
-				{
-					exit(1);
-				}
-			}
-
-			McCluskeyVals_shrink(layer);
-
-			++*newLayers;
-		}
-		optimiseLayer_recursiveVariations_impl(
-			startDepth + 1,
-			i + 1,
-			maxDepth,
-			hashSet,
-			arr,
-			indexArr,
-			numElems,
-			This,
-			baseLayer,
-			newLayers
-		);
 
-		optimiseLayer_changeCount_impl(
-			baseLayer->vals[i],
-			hashSet,
-			-1
-		);
+	const size_t idx = McCluskeyVals_find(layer, ones, dashes);
+	const bool fresh = update_findLive_impl(prevLayer, ones, dashes) == MCCLUSKEYVALS_NOT_FOUND;
+	if (present == false && idx == MCCLUSKEYVALS_NOT_FOUND)
+	{
+		return true;
 	}
-}
-bool McCluskeySolver_optimiseLayer(McCluskeySolver_t * restrict This, size_t * restrict newLayers)
-{
-	*newLayers = 0;
-	McCluskeyVals_t baseLayer;
-	McCluskeyVals_make(&baseLayer);
-
-	const McCluskeyVals_t * prevLayer = McCluskeySolver_getLayer(This);
-	if (prevLayer == NULL)
+	else if (present == false)
 	{
-		return false;
+		info->n_fresh   -= fresh;
+		info->n_garbage += McCluskeyVals_swapRemove(layer, idx);
+		return update_pushChange_impl(job, ones, dashes, true, false);
+	}
+	else if (idx == MCCLUSKEYVALS_NOT_FOUND)
+	{
+		info->n_fresh += fresh;
+		return McCluskeyVals_push(layer, &val) &&
+			McCluskeyVals_addParents(layer, layer->n_vals - 1, job->parents, (uint32_t)job->n_parents) &&
+			update_pushChange_impl(job, ones, dashes, false, true);
+	}
+	else if (layer->onTags[idx] == val.onTag && layer->dcTags[idx] == val.dcTag &&
+		update_sameParents_impl(job, layer, idx))
+	{
+		return true;
 	}
 
-	for (size_t i = 0; i < prevLayer->n_vals; ++i)
+	layer->onTags[idx] = val.onTag;
+	layer->dcTags[idx] = val.dcTag;
+	layer->states[idx] = val.state;
+	layer->lens[idx]   = val.len;
+	if (job->n_parents <= layer->parentCnt[idx])
 	{
-		if (prevLayer->vals[i]->state == McCluskeyState_one)
+		// Parents are rewritten in place
+		info->n_garbage += layer->parentCnt[idx] - job->n_parents;
+		if (job->n_parents > 0)
 		{
-			if (McCluskeyVals_push(&baseLayer, prevLayer->vals[i]) == false)
-			{
-				McCluskeyVals_destroyPreserveParents(&baseLayer);
-				return false;
-			}
+			memcpy(&layer->parents[layer->parentOff[idx]], job->parents, sizeof(uint32_t) * job->n_parents);
 		}
+		layer->parentCnt[idx] = (uint32_t)job->n_parents;
 	}
-
-	// All totally unnecessary items eliminated, already sorted array
-	if (baseLayer.n_vals < 2)
+	else
 	{
-		if (McCluskeySolver_pushLayer(This) == false)
+		info->n_garbage += layer->parentCnt[idx];
+		layer->parentCnt[idx] = 0;
+		if (McCluskeyVals_addParents(layer, idx, job->parents, (uint32_t)job->n_parents) == false)
 		{
 			return false;
 		}
-		else
-		{
-			(*McCluskeySolver_getLayer(This)) = baseLayer;
-			*newLayers = 1;
-			return true;
-		}
+	}
+	return update_pushChange_impl(job, ones, dashes, true, true);
+}
+///
+///	@brief Updates layer k from the changes of layer k - 1. Only nodes next to a
+///	changed node can change: the node itself, the node with 1 more '-' and its
+///	partners
+///	@returns Whether the operation was successful
+///
+static inline bool update_layer_impl(McCluskeySolver_t * restrict This, McCluskeyUpdate_t * restrict job, size_t k)
+{
+	McCluskeyVals_t * prevLayer = &This->set[k - 1], * layer = &This->set[k];
+	McCluskeyLayerInfo_t * info = &This->info[k];
+	if ((prevLayer->index == NULL && McCluskeyVals_buildIndex(prevLayer) == false) ||
+		(layer->index == NULL && McCluskeyVals_buildIndex(layer) == false))
+	{
+		return false;
 	}
 
-	MCHashSet_t countSet;
-	MCHashSet_make(&countSet, baseLayer.n_vals);
-
-	for (size_t i = 0; i < baseLayer.n_vals; ++i)
+	// Nodes of the layer appearing in or disappearing from the previous layer
+	for (size_t i = 0; i < job->n_changes; ++i)
 	{
-		const McCluskeyVal_t * restrict val = baseLayer.vals[i];
-		for (size_t j = 0; j < val->n_fromVec; ++j)
+		const McCluskeyChange_t * change = &job->changes[i];
+		if (change->before != change->after &&
+			McCluskeyVals_find(layer, change->ones, change->dashes) != MCCLUSKEYVALS_NOT_FOUND)
 		{
-			if (MCHashSet_push(&countSet, val->fromVec[j]->argVec) == NULL)
-			{
-				MCHashSet_destroy(&countSet);
-				McCluskeyVals_destroyPreserveParents(&baseLayer);
-				return false;
-			}
+			info->n_fresh = change->after ? (info->n_fresh - 1) : (info->n_fresh + 1);
 		}
 	}
 
-	size_t n_countSetElems = MCHashSet_getCount(&countSet);
-	MCHashSetNode_t ** countSetElems = malloc(sizeof(MCHashSetNode_t *) * n_countSetElems);
-	size_t * indexArr = malloc(sizeof(size_t) * n_countSetElems);
-
-	if (countSetElems == NULL || indexArr == NULL)
+	job->n_next = 0;
+	bool success = true;
+	for (size_t i = 0; success && i < job->n_changes; ++i)
 	{
-		if (countSetElems != NULL)
+		const McCluskeyMask_t ones = job->changes[i].ones, dashes = job->changes[i].dashes;
+		success = update_node_impl(This, job, k, ones, dashes);
+		for (McCluskeyMask_t vars = job->varMask & ~dashes; success && vars != 0; vars &= vars - 1)
 		{
-			free(countSetElems);
+			// A '0' or a '1' becomes '-', the other value
+			const McCluskeyMask_t bit = vars & (~vars + 1);
+			success = update_node_impl(This, job, k, ones & ~bit, dashes | bit) &&
+				update_node_impl(This, job, k, ones ^ bit, dashes);
 		}
-		else if (indexArr != NULL)
+		for (McCluskeyMask_t vars = dashes; success && vars != 0; vars &= vars - 1)
 		{
-			free(indexArr);
+			// A '-' becomes '1'
+			const McCluskeyMask_t bit = vars & (~vars + 1);
+			success = update_node_impl(This, job, k, ones | bit, dashes & ~bit);
 		}
-		MCHashSet_destroy(&countSet);
-		McCluskeyVals_destroyPreserveParents(&baseLayer);
-		return false;
 	}
 
-	// Fill in the array with unique elements from hash-set
-	MCHashSet_getArr(&countSet, countSetElems, n_countSetElems);
-
-	/**** Start combining different intervals ****/
-
-
-	// Combining business, at first with 1 element, then 2, etc until reaches first
-	// "full house"
-	// then return all "full houses" with that size
-
-	size_t maxDepth = n_countSetElems;
-	optimiseLayer_recursiveVariations_impl(
-		0,
-		0,
-		&maxDepth,
-		&countSet,
-		countSetElems,
-		indexArr,
-		n_countSetElems,
-		This,
-		&baseLayer,
-		newLayers
-	);
-
-	McCluskeyVals_destroyPreserveParents(&baseLayer);
-
-	// Free hash-set elems LUT
-	free(countSetElems);
-	free(indexArr);
-
-	// Destroy hash-set
-	MCHashSet_destroy(&countSet);
+	if (success && info->n_garbage > (layer->n_parents / 2))
+	{
+		success = McCluskeyVals_compactParents(layer, layer->n_parents - info->n_garbage);
+		info->n_garbage = success ? 0 : info->n_garbage;
+	}
 
-	return true;
+	MCCLUSKEY_SWAP(job->changes,     job->next);
+	MCCLUSKEY_SWAP(job->n_changes,   job->n_next);
+	MCCLUSKEY_SWAP(job->cap_changes, job->cap_next);
+	return success;
 }
-McCluskeyVals_t * McCluskeySolver_getLayer(McCluskeySolver_t * restrict This)
+///
+///	@brief Propagates the edits of the first layer through the solved layers
+///	@returns Whether the operation was successful
+///
+static inline bool update_layers_impl(McCluskeySolver_t * restrict This)
 {
-	if (This->n_set == 0)
+	McCluskeyUpdate_t job = { .ctx = This->ctx };
+	const McCluskeyVals_t * base = McCluskeySolver_getBaseLayer(This), * edits = &This->edits;
+
+	bool success = true;
+	uint8_t maxLen = 0;
+	for (size_t i = 0; i < base->n_vals; ++i)
 	{
-		return NULL;
+		maxLen = (base->lens[i] > maxLen) ? base->lens[i] : maxLen;
 	}
-	else
+	job.varMask = (maxLen >= MCCLUSKEYVAL_MAX_ARGVEC) ?
+		(McCluskeyMask_t)~(McCluskeyMask_t)0 : (((McCluskeyMask_t)1 << maxLen) - 1);
+
+	for (size_t i = 0; success && i < edits->n_vals; ++i)
 	{
-		return &This->set[This->n_set - 1];
+		// Removing outputs of a missing row doesn't add it
+		const size_t idx = McCluskeyVals_find(base, edits->ones[i], edits->dashes[i]);
+		if (idx != MCCLUSKEYVALS_NOT_FOUND &&
+			(base->onTags[idx] != edits->onTags[i] || base->dcTags[idx] != edits->dcTags[i]))
+		{
+			success = update_pushChange_impl(
+				&job, edits->ones[i], edits->dashes[i],
+				(edits->onTags[i] | edits->dcTags[i]) != 0, (base->onTags[idx] | base->dcTags[idx]) != 0
+			);
+		}
 	}
-}
+	MCCLUSKEY_SWAP(job.changes,     job.next);
+	MCCLUSKEY_SWAP(job.n_changes,   job.n_next);
+	MCCLUSKEY_SWAP(job.cap_changes, job.cap_next);
 
+	for (size_t k = 1; success && job.n_changes > 0 && k < This->n_set; ++k)
+	{
+		success = update_layer_impl(This, &job, k);
 
-struct MCHashSetNode
-{
-	uint64_t key;
-	// no data
-	MCHashSetNode_t * next;
+		// The layer became the last layer of prime implicants
+		while (success && This->info[k].n_fresh == 0 && This->n_set > (k + 1))
+		{
+			McCluskeySolver_popLayer(This);
+		}
+	}
 
-	uint32_t data;
-};
+	McCluskeyCtx_free(This->ctx, job.changes);
+	McCluskeyCtx_free(This->ctx, job.next);
+	McCluskeyCtx_free(This->ctx, job.parents);
+	McCluskeyCtx_free(This->ctx, job.sortedNew);
+	McCluskeyCtx_free(This->ctx, job.sortedOld);
 
-void * MCHashSetNode_getData(MCHashSetNode_t * restrict This)
-{
-	return &This->data;
-}
-const void * MCHashSetNode_getConstData(const MCHashSetNode_t * restrict This)
-{
-	return &This->data;
+	// The last layer has new nodes, following layers are solved from it
+	McCluskeyVals_t * layer = McCluskeySolver_getLayer(This);
+	if (success && This->info[This->n_set - 1].n_fresh > 0)
+	{
+		success = McCluskeyVals_sortWith(layer, &This->scratch);
+		for (bool more = true; success && more;)
+		{
+			success = McCluskeySolver_solveLayer(This, &more);
+		}
+	}
+	return success;
 }
-
-
 ///
-///	@brief Destroys hash-set node recursively
-///	@param node Pointer to node
+///	@brief Drops all layers above the first layer and prepares the edited first layer
+///	to be solved from scratch. Rows left without outputs are removed, the rest are
+///	sorted and made their own parents again
+///	@returns Whether the operation was successful
 ///
-static inline void MCHashSetNode_destroy(MCHashSetNode_t * restrict node)
+static inline bool McCluskeySolver_rebase_impl(McCluskeySolver_t * restrict This)
 {
-	if (node == NULL)
+	while (This->n_set > 1)
 	{
-		return;
+		McCluskeySolver_popLayer(This);
 	}
-	MCHashSetNode_destroy(node->next);
-	free(node);
-}
-
-bool MCHashSet_make(MCHashSet_t * restrict This, size_t size)
-{
-	memset(This, 0, sizeof(MCHashSet_t));
-	// Find prime number hash-set size
-	This->n_nodes = MCHashSet_findNextPrime(size);
-
-	This->nodes = calloc(This->n_nodes, sizeof(MCHashSetNode_t *));
-	if (This->nodes == NULL)
+	McCluskeyVals_t * base = McCluskeySolver_getBaseLayer(This);
+	for (size_t i = base->n_vals; i > 0; --i)
+	{
+		if ((base->onTags[i - 1] | base->dcTags[i - 1]) == 0)
+		{
+			McCluskeyVals_swapRemove(base, i - 1);
+		}
+	}
+	if (McCluskeyVals_sortWith(base, &This->scratch) == false)
 	{
-		This->n_nodes = 0;
 		return false;
 	}
 
-	return true;
+	base->n_parents = 0;
+	for (size_t i = 0; i < base->n_vals; ++i)
+	{
+		base->parentCnt[i] = 0;
+	}
+	This->layered = true;
+	return McCluskeySolver_selfParents_impl(base);
 }
-bool MCHashSet_isPrime(size_t num)
+bool McCluskeySolver_update(McCluskeySolver_t * restrict This, size_t * restrict newLayers)
 {
-	if (num == 2)
+	*newLayers = 0;
+	if (McCluskeySolver_getBaseLayer(This) == NULL)
 	{
-		return true;
+		return false;
 	}
-	else if ((num % 2) == 0)
+
+	// Previous cover is kept as the warm start of the cover search
+	McCluskeyVals_t prevCover;
+	McCluskeyVals_make(&prevCover, This->ctx);
+	if (This->n_covers > 0)
 	{
-		return false;
+		MCCLUSKEY_SWAP(prevCover, This->set[This->n_set - This->n_covers]);
+	}
+	for (; This->n_covers > 0; --This->n_covers)
+	{
+		McCluskeySolver_popLayer(This);
 	}
 
-	size_t root = (size_t)sqrtf((float)num) + 1;
-	for (size_t i = 3; i < root; i += 2)
+	bool success = true;
+	if (This->ctx->engine == McCluskeyEngine_espresso)
 	{
-		if ((num % i) == 0)
+		while (This->n_set > 1)
 		{
-			return false;
+			McCluskeySolver_popLayer(This);
 		}
 	}
-
-	return true;
-}
-size_t MCHashSet_findNextPrime(size_t lowerBound)
-{
-	if ((lowerBound % 2) == 0)
+	else if (This->n_set == 1 || This->layered == false)
 	{
-		++lowerBound;
+		success = McCluskeySolver_rebase_impl(This);
+		for (bool more = true; success && more;)
+		{
+			success = McCluskeySolver_solveLayer(This, &more);
+		}
 	}
-
-	while (MCHashSet_isPrime(lowerBound) == false)
+	else
 	{
-		lowerBound += 2;
+		success = update_layers_impl(This);
 	}
+	McCluskeyVals_clear(&This->edits);
 
-	return lowerBound;
+	success = success && optimiseLayer_impl(This, &prevCover, newLayers);
+	This->n_covers = *newLayers;
+	McCluskeyVals_destroy(&prevCover);
+	return success;
 }
 ///
-///	@param This Pointer to hash-set
-///	@param key 64-bit key to index the member in hash-set
-///	@returns Hash to represent slot index of given key
+///	@brief Adds the rows of the first layer contained in node idx of a layer at all
+///	of its outputs as its parents, in the order of the first layer. The minterms of
+///	small implicants are looked up from the index of a first layer of minterms,
+///	otherwise all rows are tested
+///	@param minterms Whether the first layer has only rows without dashes
+///	@returns Whether the operation was successful
 ///
-static inline size_t MCHashSet_hash(const MCHashSet_t * restrict This, uint64_t key)
-{
-	return (size_t)(key % (uint64_t)This->n_nodes);
-}
-bool MCHashSet_resize(MCHashSet_t * restrict This, size_t size)
+static inline bool McCluskeySolver_containedParents_impl(
+	McCluskeyVals_t * restrict base,
+	McCluskeyVals_t * restrict layer,
+	size_t idx,
+	bool minterms
+)
 {
-	size = MCHashSet_findNextPrime(size);
-	// Make new hash-set
-	MCHashSet_t newset;
-	if (MCHashSet_make(&newset, size) == false)
-	{
-		return false;
-	}
-
-	// Iterate through all elements of current hash-set
-	for (size_t i = 0; i < This->n_nodes; ++i)
-	{
-		MCHashSetNode_t * node = This->nodes[i];
-		while (node != NULL)
+	const McCluskeyMask_t ones = layer->ones[idx], dashes = layer->dashes[idx];
+	const McCluskeyTag_t tag = layer->onTags[idx] | layer->dcTags[idx];
+	const uint8_t n_dashes = McCluskeyMask_popcount(dashes);
+	if (minterms && n_dashes < 32 && (UINT64_C(1) << n_dashes) <= base->n_vals)
+	{
+		const size_t from = layer->n_parents;
+		// Enumerates the subsets of the dashes
+		McCluskeyMask_t sub = 0;
+		do
 		{
-			if (MCHashSet_push(&newset, node->key) == false)
+			const size_t row = McCluskeyVals_find(base, (ones & ~dashes) | sub, 0);
+			const uint32_t parent = (uint32_t)row;
+			if (row != MCCLUSKEYVALS_NOT_FOUND && base->states[row] != McCluskeyState_undefined &&
+				(tag & ~(base->onTags[row] | base->dcTags[row])) == 0 &&
+				McCluskeyVals_addParents(layer, idx, &parent, 1) == false
+			)
 			{
-				MCHashSet_destroy(&newset);
 				return false;
 			}
-			node = node->next;
-		}
+			sub = (sub - dashes) & dashes;
+		} while (sub != 0);
+
+		qsort(&layer->parents[from], layer->n_parents - from, sizeof(uint32_t), &McCluskey_cmpParents);
+		return true;
 	}
 
-	MCHashSet_destroy(This);
-	*This = newset;
+	for (size_t i = 0; i < base->n_vals; ++i)
+	{
+		const uint32_t parent = (uint32_t)i;
+		if (base->states[i] != McCluskeyState_undefined &&
+			(base->dashes[i] & ~dashes) == 0 && ((base->ones[i] ^ ones) & ~dashes) == 0 &&
+			(tag & ~(base->onTags[i] | base->dcTags[i])) == 0 &&
+			McCluskeyVals_addParents(layer, idx, &parent, 1) == false
+		)
+		{
+			return false;
+		}
+	}
 	return true;
 }
-MCHashSetNode_t * MCHashSet_push(MCHashSet_t * restrict This, uint64_t key)
+bool McCluskeySolver_loadPrimes(McCluskeySolver_t * restrict This, const McCluskeyVal_t * restrict primes, size_t n_primes)
 {
-	if (This->n_elems > This->n_nodes)
+	McCluskeyVals_t * base = McCluskeySolver_getBaseLayer(This);
+	if (base == NULL)
 	{
-		MCHashSet_resize(This, This->n_elems * 2 + 1);
+		return false;
 	}
-	size_t index = MCHashSet_hash(This, key);
-	
-	// Search if node already exists
-	MCHashSetNode_t * prevnode = NULL, * node = This->nodes[index];
-	while (node != NULL)
+	bool minterms = true;
+	for (size_t i = 0; minterms && i < base->n_vals; ++i)
 	{
-		// Found previously pushed node
-		if (node->key == key)
-		{
-			return node;
-		}
-		prevnode = node;
-		node = node->next;
+		minterms = (base->dashes[i] == 0);
 	}
-	// Create new node
-	MCHashSetNode_t * newnode = calloc(1, sizeof(MCHashSetNode_t));
-	if (newnode == NULL)
+	if (minterms && base->index == NULL && McCluskeyVals_buildIndex(base) == false)
 	{
-		return NULL;
+		return false;
 	}
 
-	newnode->key = key;
-
-	if (prevnode == NULL)
+	while (This->n_set > 1)
 	{
-		This->nodes[index] = newnode;
+		McCluskeySolver_popLayer(This);
 	}
-	else
+	This->n_covers = 0;
+	This->layered  = false;
+	if (McCluskeySolver_pushLayer(This) == false)
 	{
-		prevnode->next = newnode;
+		return false;
 	}
-
-	++This->n_elems;
-	return newnode;
-}
-bool MCHashSet_pop(MCHashSet_t * restrict This, uint64_t key)
-{
-	if (This->n_elems == 0)
+	// Pushing may move the layers
+	base = McCluskeySolver_getBaseLayer(This);
+	McCluskeyVals_t * layer = McCluskeySolver_getLayer(This);
+	if (McCluskeyVals_reserve(layer, n_primes) == false)
 	{
+		McCluskeySolver_popLayer(This);
 		return false;
 	}
-	
-	size_t index = MCHashSet_hash(This, key);
-	MCHashSetNode_t * prevnode = NULL, * node = This->nodes[index];
-	while (node != NULL)
+	for (size_t i = 0; i < n_primes; ++i)
 	{
-		if (node->key == key)
+		if (McCluskeyVals_push(layer, &primes[i]) == false ||
+			McCluskeySolver_containedParents_impl(base, layer, i, minterms) == false
+		)
 		{
-			if (prevnode == NULL)
-			{
-				This->nodes[index] = node->next;
-			}
-			else
-			{
-				prevnode->next = node->next;
-			}
-			free(node);
-
-			--This->n_elems;
-			return true;
+			McCluskeySolver_popLayer(This);
+			return false;
 		}
-
-		prevnode = node;
-		node = node->next;
 	}
-
-	return false;
+	return true;
 }
-bool MCHashSet_exists(const MCHashSet_t * restrict This, uint64_t key)
+bool McCluskeySolver_loadCover(McCluskeySolver_t * restrict This, const uint32_t * restrict terms, size_t n_terms)
 {
-	if (This->n_elems == 0)
+	if (This->layered || This->n_set < 2 || McCluskeySolver_pushLayer(This) == false)
 	{
 		return false;
 	}
-	
-	size_t index = MCHashSet_hash(This, key);
-	MCHashSetNode_t * node = This->nodes[index];
-	while (node != NULL)
+	McCluskeyVals_t * layer = McCluskeySolver_getLayer(This);
+	const McCluskeyVals_t * primes = layer - 1 - This->n_covers;
+	for (size_t i = 0; i < n_terms; ++i)
 	{
-		if (node->key == key)
+		if (terms[i] >= primes->n_vals || McCluskeyVals_pushFrom(layer, primes, terms[i]) == false)
 		{
-			return true;
+			McCluskeySolver_popLayer(This);
+			return false;
 		}
-
-		node = node->next;
 	}
-
-	return false;
+	++This->n_covers;
+	return true;
 }
-MCHashSetNode_t * MCHashSet_get(MCHashSet_t * restrict This, uint64_t key)
+McCluskeyVals_t * McCluskeySolver_getLayer(McCluskeySolver_t * restrict This)
 {
-	if (This->n_elems == 0)
+	if (This->n_set == 0)
 	{
 		return NULL;
 	}
-	
-	size_t index = MCHashSet_hash(This, key);
-	MCHashSetNode_t * node = This->nodes[index];
-	while (node != NULL)
+	else
 	{
-		if (node->key == key)
-		{
-			return node;
-		}
-
-		node = node->next;
+		return &This->set[This->n_set - 1];
 	}
-
-	return NULL;
-}
-size_t MCHashSet_getCount(const MCHashSet_t * restrict This)
-{
-	return This->n_elems;
 }
-bool MCHashSet_getArr(MCHashSet_t * restrict This, MCHashSetNode_t ** array, size_t arrMax)
+McCluskeyVals_t * McCluskeySolver_getBaseLayer(McCluskeySolver_t * restrict This)
 {
-	if (This->n_elems > arrMax)
+	if (This->n_set == 0)
 	{
-		return false;
+		return NULL;
 	}
-
-	size_t arrIdx = 0;
-	for (size_t i = 0; i < This->n_nodes; ++i)
+	else
 	{
-		MCHashSetNode_t * node = This->nodes[i];
-		while (node != NULL)
+		return &This->set[0];
+	}
+}
+///
+///	@brief Adds the probe lengths of finding every indexed node of a layer, the
+///	distance of its slot from its home slot plus 1
+///
+static inline void McCluskeySolver_probeStats_impl(const McCluskeyVals_t * restrict layer, McCluskeyStats_t * restrict stats)
+{
+	const size_t mask = layer->n_index - 1;
+	for (size_t slot = 0; layer->index != NULL && slot < layer->n_index; ++slot)
+	{
+		if (layer->index[slot] == 0)
 		{
-			array[arrIdx] = node;
-			++arrIdx;
-
-			node = node->next;
+			continue;
 		}
+		const size_t idx  = layer->index[slot] - 1;
+		const size_t home = (size_t)McCluskey_hashKey(McCluskeyMask_key(layer->ones[idx], layer->dashes[idx])) & mask;
+		const uint64_t length = (uint64_t)((slot - home) & mask) + 1;
+		++stats->probes;
+		stats->probeLength += length;
+		stats->maxProbe     = (length > stats->maxProbe) ? length : stats->maxProbe;
 	}
-	
-	return true;
 }
-
-void MCHashSet_destroy(MCHashSet_t * restrict This)
+void McCluskeySolver_getStats(const McCluskeySolver_t * restrict This, McCluskeyStats_t * restrict stats)
 {
-	if (This->n_nodes > 0)
+	*stats = This->stats;
+	stats->n_layers = This->n_set - This->n_covers;
+	for (size_t i = 0; i < stats->n_layers; ++i)
 	{
-		for (size_t i = 0; i < This->n_nodes; ++i)
+		if (i < (MCCLUSKEYVAL_MAX_ARGVEC + 2))
 		{
-			if (This->nodes[i] != NULL)
-			{
-				MCHashSetNode_destroy(This->nodes[i]);
-			}
+			stats->layerNodes[i] = This->set[i].n_vals;
 		}
-		free(This->nodes);
-		
-		This->nodes   = NULL;
-		This->n_nodes = 0;
-		This->n_elems = 0;
+		McCluskeySolver_probeStats_impl(&This->set[i], stats);
 	}
+
+	stats->n_covers  = This->n_covers;
+	stats->coverSize = (This->n_covers > 0) ? This->set[This->n_set - 1].n_vals : 0;
 }
+
@@ -2,6 +2,7 @@
 #define MC_CLUSKEY_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 
 
@@ -23,6 +24,138 @@ enum McCluskeyState
 #define MCCLUSKEYSTATE_LAST_CHAR ((uint8_t)'1')
 
 
+typedef uint8_t McCluskeyMode_t;
+
+///
+///	@brief Enumerator for McCluskey's display modes
+///
+enum McCluskeyMode
+{
+	McCluskeyMode_one,
+	McCluskeyMode_zero
+};
+
+typedef uint8_t McCluskeyPrimeMode_t;
+typedef uint8_t McCluskeyEngine_t;
+
+///
+///	@brief Enumerator for prime implicant generation methods
+///
+enum McCluskeyPrimeMode
+{
+	// Compare every node of a group with every node of the next group
+	McCluskeyPrimeMode_pairScan,
+	// Look up the only possible partners of every node from the layer's hash index
+	McCluskeyPrimeMode_lookup
+};
+
+///
+///	@brief Enumerator for minimisation engines
+///
+enum McCluskeyEngine
+{
+	// Generate all prime implicants and search all minimum covers
+	McCluskeyEngine_exact,
+	// Heuristic Espresso-style cube iteration, finds 1 near-minimal cover
+	McCluskeyEngine_espresso
+};
+
+///
+///	@brief Memory allocator with the semantics of realloc, size 0 frees the memory
+///	@param user User data given to McCluskeyCtx_setAllocator
+///	@param ptr Pointer to memory, NULL allocates new memory
+///	@param size New size in bytes
+///	@returns Pointer to memory, NULL on failure or if the memory was freed
+///
+typedef void * (*McCluskeyAllocFunc_t)(void * user, void * ptr, size_t size);
+
+///
+///	@brief Context of solving, holds the value mode, the allocator of node memory
+///	and the solver options. Objects only read their context, so independent
+///	problems with separate contexts can be solved concurrently
+///
+typedef struct McCluskeyCtx
+{
+	McCluskeyMode_t mode;
+
+	McCluskeyAllocFunc_t alloc;
+	void * allocUser;
+
+	McCluskeyPrimeMode_t primeMode;
+	McCluskeyEngine_t engine;
+	size_t n_threads;
+	bool lowMemory;
+	// Budget of each cover search, 0 if unlimited
+	double timeBudget;
+	uint64_t nodeBudget;
+
+} McCluskeyCtx_t;
+
+///
+///	@brief Initialises a context with ones' mode, the standard allocator, pair scan
+///	prime generation, the exact engine, 1 thread, low-memory mode off and an
+///	unlimited cover search
+///	@param This Pointer to context
+///
+void McCluskeyCtx_make(McCluskeyCtx_t * restrict This);
+///
+///	@brief Sets the value mode
+///	@param This Pointer to context
+///	@param modeCh character representing mode, '0' selects McCluskeyMode_zero,
+///	anything else McCluskeyMode_one
+///
+void McCluskeyCtx_setMode(McCluskeyCtx_t * restrict This, char modeCh);
+///
+///	@brief Sets the allocator of node memory, must not be changed while any
+///	object using the context holds memory
+///	@param This Pointer to context
+///	@param alloc Allocator function
+///	@param user User data passed to the allocator
+///
+void McCluskeyCtx_setAllocator(McCluskeyCtx_t * restrict This, McCluskeyAllocFunc_t alloc, void * user);
+///
+///	@brief Selects the method used by McCluskeySolver_solveLayer to find mergeable
+///	nodes, defaults to McCluskeyPrimeMode_pairScan
+///	@param This Pointer to context
+///	@param mode Prime implicant generation method
+///
+void McCluskeyCtx_setPrimeMode(McCluskeyCtx_t * restrict This, McCluskeyPrimeMode_t mode);
+///
+///	@brief Selects the minimisation engine, defaults to McCluskeyEngine_exact. With
+///	McCluskeyEngine_espresso McCluskeySolver_solveLayer generates no layers and
+///	McCluskeySolver_optimiseLayer minimises the input layer directly
+///	@param This Pointer to context
+///	@param engine Minimisation engine
+///
+void McCluskeyCtx_setEngine(McCluskeyCtx_t * restrict This, McCluskeyEngine_t engine);
+///
+///	@brief Sets the number of worker threads used by McCluskeySolver_solveLayer and
+///	McCluskeySolver_optimiseLayer, defaults to 1
+///	@param This Pointer to context
+///	@param n_threads Number of threads, 0 uses all hardware threads
+///
+void McCluskeyCtx_setThreads(McCluskeyCtx_t * restrict This, size_t n_threads);
+///
+///	@brief Selects low-memory mode, in which McCluskeySolver_solveLayer keeps only the
+///	first layer and the newest layer instead of all layers, so that at most 3 layers
+///	are resident while solving. McCluskeySolver_update then solves the edited table
+///	from scratch instead of updating the layers. Defaults to false
+///	@param This Pointer to context
+///	@param lowMemory Whether to drop consumed layers
+///
+void McCluskeyCtx_setLowMemory(McCluskeyCtx_t * restrict This, bool lowMemory);
+///
+///	@brief Limits the cover search of each McCluskeySolver_optimiseLayer call of the
+///	exact engine. The search starts from a greedy cover and returns the smallest
+///	covers found when the budget runs out, McCluskeySolver_isExpired then tells that
+///	they aren't proven minimum. Defaults to no limit
+///	@param This Pointer to context
+///	@param seconds Wall-clock time per search, 0 if unlimited
+///	@param nodes Search tree nodes per search, 0 if unlimited
+///
+void McCluskeyCtx_setBudget(McCluskeyCtx_t * restrict This, double seconds, uint64_t nodes);
+
+
 extern const McCluskeyState_t McCluskeyStateChars[MCCLUSKEYSTATE_LAST_CHAR + 1];
 extern const char McCluskeyStateCharsRev[MCCLUSKEYSTATE_NUM];
 
@@ -36,58 +169,181 @@ McCluskeyState_t McCluskey_getRawState(char stateCh);
 char McCluskey_getRawChar(McCluskeyState_t state);
 
 ///
+///	@param ctx Pointer to context
 ///	@returns Corresponding McCluskeyState to character, 0, if illegal state
 ///	adjusts to value mode
 ///
-McCluskeyState_t McCluskey_getState(char stateCh);
+McCluskeyState_t McCluskey_getState(const McCluskeyCtx_t * restrict ctx, char stateCh);
 ///
+///	@param ctx Pointer to context
 ///	@returns Corresponding character to McCluskeyState, -1, if illegal state
 ///	adjusts to value mode
 ///
-char McCluskey_getChar(McCluskeyState_t state);
-
-#define MCCLUSKEYVAL_MAX_ARGVEC 32
+char McCluskey_getChar(const McCluskeyCtx_t * restrict ctx, McCluskeyState_t state);
 
 ///
-///	@brief Data structure to hold 1 McCluskey's node
+///	@brief Maximum number of variables, selected at compile time, 32, 64 or 128
 ///
-typedef struct McCluskeyVal
-{
-	uint64_t argVec;
-	uint8_t numOnes:6;
-	McCluskeyState_t state:2;
+#ifndef MCCLUSKEY_WIDTH
+	#define MCCLUSKEY_WIDTH 32
+#endif
 
-	const struct McCluskeyVal ** fromVec;
-	size_t cap_fromVec, n_fromVec;
+#define MCCLUSKEYVAL_MAX_ARGVEC MCCLUSKEY_WIDTH
 
-} McCluskeyVal_t;
+///
+///	@brief Bit mask type holding 1 bit per variable of an argument vector
+///
+#if MCCLUSKEY_WIDTH == 32
+	typedef uint32_t McCluskeyMask_t;
+#elif MCCLUSKEY_WIDTH == 64
+	typedef uint64_t McCluskeyMask_t;
+#elif MCCLUSKEY_WIDTH == 128
+	__extension__ typedef unsigned __int128 McCluskeyMask_t;
+#else
+	#error "MCCLUSKEY_WIDTH must be 32, 64 or 128"
+#endif
 
+///
+///	@param mask Bit mask
+///	@returns Number of set bits in mask
+///
+static inline uint8_t McCluskeyMask_popcount(McCluskeyMask_t mask)
+{
+#if MCCLUSKEY_WIDTH == 32
+	return (uint8_t)__builtin_popcount(mask);
+#elif MCCLUSKEY_WIDTH == 64
+	return (uint8_t)__builtin_popcountll(mask);
+#else
+	return (uint8_t)(__builtin_popcountll((uint64_t)mask) + __builtin_popcountll((uint64_t)(mask >> 64)));
+#endif
+}
+///
+///	@param mask Non-empty bit mask
+///	@returns Index of the lowest set bit of mask
+///
+static inline uint8_t McCluskeyMask_ctz(McCluskeyMask_t mask)
+{
+#if MCCLUSKEY_WIDTH == 32
+	return (uint8_t)__builtin_ctz(mask);
+#elif MCCLUSKEY_WIDTH == 64
+	return (uint8_t)__builtin_ctzll(mask);
+#else
+	return ((uint64_t)mask != 0) ? (uint8_t)__builtin_ctzll((uint64_t)mask) :
+		(uint8_t)(64 + __builtin_ctzll((uint64_t)(mask >> 64)));
+#endif
+}
+///
+///	@param x 64-bit word
+///	@returns x with the order of its bits reversed
+///
+static inline uint64_t McCluskey_reverse64(uint64_t x)
+{
+	x = __builtin_bswap64(x);
+	x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+	x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+	return x;
+}
+///
+///	@param mask Bit mask
+///	@param len Number of low bits to reverse, in range [1, MCCLUSKEY_WIDTH]
+///	@returns The low len bits of mask in reverse order
+///
+static inline McCluskeyMask_t McCluskeyMask_reverse(McCluskeyMask_t mask, uint8_t len)
+{
+#if MCCLUSKEY_WIDTH == 32
+	return (McCluskeyMask_t)(McCluskey_reverse64((uint64_t)mask) >> (64 - len));
+#elif MCCLUSKEY_WIDTH == 64
+	return McCluskey_reverse64(mask) >> (64 - len);
+#else
+	const McCluskeyMask_t rev = ((McCluskeyMask_t)McCluskey_reverse64((uint64_t)mask) << 64) |
+		McCluskey_reverse64((uint64_t)(mask >> 64));
+	return rev >> (128 - len);
+#endif
+}
+///
+///	@param mask Bit mask
+///	@returns Number of bits needed to hold the highest set bit of mask, 0 if mask is empty
+///
+static inline uint8_t McCluskeyMask_bitLen(McCluskeyMask_t mask)
+{
+	if (mask == 0)
+	{
+		return 0;
+	}
+#if MCCLUSKEY_WIDTH == 32
+	return (uint8_t)(32 - __builtin_clz(mask));
+#elif MCCLUSKEY_WIDTH == 64
+	return (uint8_t)(64 - __builtin_clzll(mask));
+#else
+	return ((mask >> 64) != 0) ? (uint8_t)(128 - __builtin_clzll((uint64_t)(mask >> 64))) :
+		(uint8_t)(64 - __builtin_clzll((uint64_t)mask));
+#endif
+}
+///
+///	@param ones Mask of ones of an argument vector
+///	@param dashes Mask of dashes of an argument vector
+///	@returns 64-bit key of the argument vector, unique up to 32 variables
+///
+static inline uint64_t McCluskeyMask_key(McCluskeyMask_t ones, McCluskeyMask_t dashes)
+{
+#if MCCLUSKEY_WIDTH == 32
+	return ((uint64_t)dashes << 32) | (uint64_t)ones;
+#elif MCCLUSKEY_WIDTH == 64
+	return ones ^ (dashes * UINT64_C(0x9e3779b97f4a7c15));
+#else
+	return (uint64_t)ones ^ ((uint64_t)(ones >> 64) * UINT64_C(0xc2b2ae3d27d4eb4f)) ^
+		((uint64_t)dashes * UINT64_C(0x9e3779b97f4a7c15)) ^ ((uint64_t)(dashes >> 64) * UINT64_C(0x165667b19e3779f9));
+#endif
+}
 
-typedef uint8_t McCluskeyMode_t;
+///
+///	@brief Maximum number of output columns of a truth table
+///
+#define MCCLUSKEYVAL_MAX_OUTPUTS 32
 
 ///
-///	@brief Enumerator for McCluskey's display modes
+///	@brief Bit mask type holding 1 bit per output column, bit i corresponding to
+///	output i (counted from the left end of the values)
 ///
-enum McCluskeyMode
-{
-	McCluskeyMode_one,
-	McCluskeyMode_zero
-};
+typedef uint32_t McCluskeyTag_t;
 
 ///
-///	@brief Set mode for McCluskey
-///	@param modeCh character representing mode, mode defaults to McCluskeyMode_one
+///	@brief Data structure to hold 1 McCluskey's node
+///
+///	The argument vector is stored as 2 bit masks, bit i corresponding to variable i
+///	(counted from the right end of the vector). A bit set in "dashes" marks the
+///	variable as '-', a bit set in "ones" marks it as '1', otherwise the variable is
+///	'0'. Bits at or above "len" are always cleared.
+///
+///	The output tags mark the outputs the node is an implicant of: "onTag" the
+///	outputs where it covers at least 1 '1', "dcTag" the outputs where it covers
+///	only '-'. "state" is McCluskeyState_one if onTag is not empty, otherwise
+///	McCluskeyState_undefined.
 ///
-void McCluskeyVal_setMode(char modeCh);
+typedef struct McCluskeyVal
+{
+	McCluskeyMask_t ones, dashes;
+	McCluskeyTag_t onTag, dcTag;
+	uint8_t len;
+	uint8_t numOnes;
+	uint8_t n_outputs;
+	McCluskeyState_t state;
+
+} McCluskeyVal_t;
+
 
 ///
 ///	@brief Creates a McCluskeyVal_t object, converting characters to internal values
 ///	@param This Pointer to the current node
+///	@param ctx Pointer to context, values are read in its mode
 ///	@param argvec Null-terminated character array of argument vector
-///	@param value Character denoting value of said argument vector
-///	@returns Whether the operation was 100% successful
+///	@param values Null-terminated character array of the values of said argument
+///	vector, 1 character per output
+///	@returns Whether the operation was 100% successful, fails if no output is
+///	defined
 ///
-bool McCluskeyVal_make(McCluskeyVal_t * restrict This, const char * argvec, char value);
+bool McCluskeyVal_make(McCluskeyVal_t * restrict This, const McCluskeyCtx_t * restrict ctx, const char * argvec, const char * values);
 ///
 ///	@param This Pointer to the current node
 ///	@param idx McCluskey's bit index
@@ -102,28 +358,11 @@ McCluskeyState_t McCluskeyVal_getArgBit(const McCluskeyVal_t * restrict This, ui
 ///
 void McCluskeyVal_putArgBit(McCluskeyVal_t * restrict This, uint8_t idx, McCluskeyState_t value);
 
-///
-///	@brief Adds a parent node to selected McCluskey's node
-///	@param This Pointer to the current node
-///	@param parent Pointer to the "parent" node to add
-///	@returns Whether the operation was successful
-///
-bool McCluskeyVal_addParent(McCluskeyVal_t * restrict This, const McCluskeyVal_t * restrict parent);
-///
-///	@brief Shrinks the memory usage of parent nodes to the minimum
-///	@param This Pointer to the current node
-///	@returns Whether the operation was successful, data preserve guarantee
-///
-bool McCluskeyVal_shrinkParents(McCluskeyVal_t * restrict This);
-///
-///	@brief De-allocates/"destroys" the memory of objects' parent nodes
-///	@param This Pointer to the current node
-///
-void McCluskeyVal_destroy(McCluskeyVal_t * restrict This);
 ///
 ///	@param lhs first operand
 ///	@param rhs second operand
-///	@returns Whether 2 given argument vectors can be merged
+///	@returns Whether 2 given argument vectors can be merged, they have to be
+///	implicants of at least 1 common output
 ///
 bool McCluskeyVal_canMerge(const McCluskeyVal_t * restrict lhs, const McCluskeyVal_t * restrict rhs);
 ///
@@ -171,9 +410,19 @@ uint8_t McCluskeyVal_getMaxLen(
 bool McCluskeyVal_getVecStr(const McCluskeyVal_t * restrict This, char * restrict str, size_t maxStr);
 ///
 ///	@param This Pointer to current node
+///	@param ctx Pointer to context
 ///	@returns Character representing value state
 ///
-char McCluskeyVal_getStateCh(const McCluskeyVal_t * restrict This);
+char McCluskeyVal_getStateCh(const McCluskeyVal_t * restrict This, const McCluskeyCtx_t * restrict ctx);
+///
+///	@brief Converts internally stored output tags to string, 1 character per output
+///	@param This Pointer to current node
+///	@param ctx Pointer to context, characters are written in its mode
+///	@param str character array to receive string
+///	@param maxStr maximum size of given character array
+///	@returns Whether the given array was big enough for said string
+///
+bool McCluskeyVal_getOutStr(const McCluskeyVal_t * restrict This, const McCluskeyCtx_t * restrict ctx, char * restrict str, size_t maxStr);
 ///
 ///	@param vec1 Pointer to first operand
 ///	@param vec2 Pointer to second operand
@@ -186,35 +435,127 @@ bool McCluskeyVal_equal(const McCluskeyVal_t * restrict vec1, const McCluskeyVal
 ///
 ///	@brief Data structure to hold an array of McCluskey's nodes
 ///
+///	Nodes are stored as a structure of arrays and referred to by their 32-bit
+///	index. Parent references of all nodes share 1 contiguous pool, node i owning
+///	the range [parentOff[i], parentOff[i] + parentCnt[i]). Parent references are
+///	indices to the nodes of the solver's first layer.
+///
 typedef struct McCluskeyVals
 {
-	McCluskeyVal_t ** vals;
+	McCluskeyMask_t * ones, * dashes;
+	McCluskeyTag_t * onTags, * dcTags;
+	uint8_t * lens, * numOnes;
+	McCluskeyState_t * states;
+	size_t * parentOff;
+	uint32_t * parentCnt;
 	size_t cap_vals, n_vals;
 
+	uint32_t * parents;
+	size_t cap_parents, n_parents;
+
+	// Open-addressing hash index by argument vector, holds node index + 1 per
+	// slot, 0 marks an empty slot. NULL until built, kept up to date afterwards
+	uint32_t * index;
+	size_t n_index;
+
+	// Number of outputs, the largest of all pushed nodes
+	uint8_t n_outputs;
+
+	// Context providing the allocator, arrays exchanging memory must share it
+	const McCluskeyCtx_t * ctx;
+
 } McCluskeyVals_t;
 
+#define MCCLUSKEYVALS_NOT_FOUND SIZE_MAX
+
 ///
 ///	@brief Initialises McCluskeyVals_t object
 ///	@param This Pointer to the object to be initialised
+///	@param ctx Pointer to context, must outlive the object
 ///
-void McCluskeyVals_make(McCluskeyVals_t * restrict This);
+void McCluskeyVals_make(McCluskeyVals_t * restrict This, const McCluskeyCtx_t * restrict ctx);
 ///
-///	@brief Adds/"pushes" a McCluskey's node to end of the array of nodes
+///	@brief Ensures that the array has room for at least cap nodes
 ///	@param This Pointer to object
+///	@param cap Minimum capacity
+///	@returns Whether the operation was successful
+///
+bool McCluskeyVals_reserve(McCluskeyVals_t * restrict This, size_t cap);
+///
+///	@brief Adds/"pushes" a McCluskey's node without parents to end of the array of nodes
+///	@param This Pointer to object
+///	@param val Pointer to node
 ///	@returns Whether the operation was successful
 ///
 bool McCluskeyVals_push(McCluskeyVals_t * restrict This, const McCluskeyVal_t * restrict val);
 ///
-///	@brief Removes/"pops" a McCluskey's node from the end of array of nodes
+///	@brief Adds/"pushes" a McCluskey's node without parents to end of the array of
+///	nodes, unless an equal node already exists, in which case the output tags of
+///	the node are added to the existing node. Builds the index if necessary
 ///	@param This Pointer to object
+///	@param val Pointer to node
+///	@param inserted Pointer to variable receiving whether the node was added
 ///	@returns Whether the operation was successful
 ///
-bool McCluskeyVals_pop(McCluskeyVals_t * restrict This);
+bool McCluskeyVals_pushUnique(McCluskeyVals_t * restrict This, const McCluskeyVal_t * restrict val, bool * restrict inserted);
 ///
+///	@brief Adds/"pushes" a copy of another array's node together with its parents
 ///	@param This Pointer to object
-///	@returns Last McCluskey's node, NULL, if no objects exist
+///	@param src Pointer to source array of nodes
+///	@param idx Index of node in source array
+///	@returns Whether the operation was successful
 ///
-McCluskeyVal_t * McCluskeyVals_getLast(McCluskeyVals_t * restrict This);
+bool McCluskeyVals_pushFrom(McCluskeyVals_t * restrict This, const McCluskeyVals_t * restrict src, size_t idx);
+///
+///	@brief Appends parent references to a node. Only the node with the newest parent
+///	references or a node without any parents can receive new parents
+///	@param This Pointer to object
+///	@param idx Index of node
+///	@param parents Array of parent indices
+///	@param n_parents Number of parents
+///	@returns Whether the operation was successful
+///
+bool McCluskeyVals_addParents(
+	McCluskeyVals_t * restrict This,
+	size_t idx,
+	const uint32_t * restrict parents,
+	uint32_t n_parents
+);
+///
+///	@brief Builds the hash index of all nodes, index is maintained by all further
+///	modifications
+///	@param This Pointer to object
+///	@returns Whether the operation was successful
+///
+bool McCluskeyVals_buildIndex(McCluskeyVals_t * restrict This);
+///
+///	@param This Pointer to object
+///	@param ones Mask of ones of the searched argument vector
+///	@param dashes Mask of dashes of the searched argument vector
+///	@returns Index of node with given argument vector, MCCLUSKEYVALS_NOT_FOUND if
+///	there is no such node or the array has no index
+///
+size_t McCluskeyVals_find(const McCluskeyVals_t * restrict This, McCluskeyMask_t ones, McCluskeyMask_t dashes);
+///
+///	@brief Copies a node's argument vector and state
+///	@param This Pointer to object
+///	@param idx Index of node
+///	@param val Pointer to receiving node
+///
+void McCluskeyVals_get(const McCluskeyVals_t * restrict This, size_t idx, McCluskeyVal_t * restrict val);
+///
+///	@param This Pointer to object
+///	@param idx Index of node
+///	@param n_parents Pointer to variable receiving the number of parents
+///	@returns Pointer to node's parent indices, NULL if node has no parents
+///
+const uint32_t * McCluskeyVals_getParents(const McCluskeyVals_t * restrict This, size_t idx, uint32_t * restrict n_parents);
+///
+///	@brief Removes/"pops" a McCluskey's node from the end of array of nodes
+///	@param This Pointer to object
+///	@returns Whether the operation was successful
+///
+bool McCluskeyVals_pop(McCluskeyVals_t * restrict This);
 ///
 ///	@brief Shrinks memory usage of McCluskey's nodes to a minimum
 ///	@param This Poiner to object
@@ -222,48 +563,162 @@ McCluskeyVal_t * McCluskeyVals_getLast(McCluskeyVals_t * restrict This);
 ///
 bool McCluskeyVals_shrink(McCluskeyVals_t * restrict This);
 ///
+///	@brief Removes all nodes and parent references, keeping the allocated memory
+///	and the index for reuse
+///	@param This Pointer to object
+///
+void McCluskeyVals_clear(McCluskeyVals_t * restrict This);
+///
 ///	@brief De-allocates/"destroys" the memory of McCluskey's array of nodes
 ///	@param This Pointer to the current node
 ///
 void McCluskeyVals_destroy(McCluskeyVals_t * restrict This);
 ///
-///	@brief De-allocates/"destroys" the memory of McCluskey's array of nodes,
-///	while preserving the allocated memory of parent nodes
+///	@brief Removes duplicates from nodes in 1 pass, keeping the first occurrences
+///	in their original order with the output tags of all occurrences. Builds the index
 ///	@param This Pointer to the current node
+///	@returns Whether the operation was successful
 ///
-void McCluskeyVals_destroyPreserveParents(McCluskeyVals_t * restrict This);
+bool McCluskeyVals_removeDuplicates(McCluskeyVals_t * restrict This);
 ///
-///	@brief Removes duplicates from nodes
+///	@brief Sorts the array of McCluskey's nodes by the number of ones in the
+///	input argument vectors
 ///	@param This Pointer to the current node
+///	@returns Whether the operation was successful
 ///
-void McCluskeyVals_removeDuplicates(McCluskeyVals_t * restrict This);
+bool McCluskeyVals_sort(McCluskeyVals_t * restrict This);
 ///
 ///	@brief Sorts the array of McCluskey's nodes by the number of ones in the
-///	input argument vectors
+///	input argument vectors, using the node memory of another array as the
+///	destination. The arrays swap their node memory
 ///	@param This Pointer to the current node
+///	@param scratch Pointer to array lending its node memory, left empty
+///	@returns Whether the operation was successful
 ///
-void McCluskeyVals_sort(McCluskeyVals_t * restrict This);
+bool McCluskeyVals_sortWith(McCluskeyVals_t * restrict This, McCluskeyVals_t * restrict scratch);
 
 
 
+///
+///	@brief Evaluates a statistics counter update, compiled out with MCCLUSKEY_NO_STATS
+///
+#ifdef MCCLUSKEY_NO_STATS
+	// Not evaluated, the operands still count as used
+	#define MCCLUSKEY_STAT(expr) ((void)sizeof(expr))
+#else
+	#define MCCLUSKEY_STAT(expr) ((void)(expr))
+#endif
+
+///
+///	@brief Algorithmic counters of a solver. Layer generation is counted from
+///	McCluskeySolver_reset on, the cover search counters describe the last
+///	optimisation. The counters stay 0 when compiled with MCCLUSKEY_NO_STATS, the
+///	layer nodes and index probes are measured by McCluskeySolver_getStats
+///
+typedef struct McCluskeyStats
+{
+	// Node pairs compared by pair scan or partners looked up by McCluskeySolver_solveLayer
+	uint64_t comparisons;
+	// Pairs of nodes with a common output merged into a node
+	uint64_t merges;
+	// Merged nodes dropped as already generated from another pair
+	uint64_t duplicates;
+	// Duplicate rows of the first layer merged by McCluskeyVals_removeDuplicates
+	uint64_t duplicateRows;
+
+	// Number of layers below the cover layers and their nodes, the first layer
+	// holding the input rows. Layers beyond the array aren't listed, in low-memory
+	// mode only the first and the last layer are resident
+	size_t n_layers;
+	size_t layerNodes[MCCLUSKEYVAL_MAX_ARGVEC + 2];
+
+	// Prime implicants and essential prime implicants of the cover search
+	size_t n_primes, n_essential;
+	// Search tree nodes visited and covers recorded by the cover search, including
+	// covers later found not to be minimal
+	uint64_t coverNodes, coversFound;
+	// Minimum covers and their size
+	size_t n_covers, coverSize;
+
+	// Hash index probes of the indexed layers: indexed nodes, total and longest
+	// number of slots probed to find a node
+	uint64_t probes, probeLength, maxProbe;
+
+	// Name of the pair scan kernel, NULL if no layer was solved by pair scan
+	const char * kernel;
+
+} McCluskeyStats_t;
+
+///
+///	@brief Bookkeeping of 1 solver layer for incremental updates
+///
+typedef struct McCluskeyLayerInfo
+{
+	// Number of nodes not contained in the previous layer, the layers are solved
+	// until a layer has none
+	size_t n_fresh;
+	// Number of parent references in the pool no longer owned by any node
+	size_t n_garbage;
+
+} McCluskeyLayerInfo_t;
+
 ///
 ///	@brief Data structure to hold a set of McCluskeyVals_t objects helping to
 ///	solve the problem
 ///
 typedef struct McCluskeySolver
 {
+	// Layers beyond n_set are kept empty with their memory for reuse
 	McCluskeyVals_t * set;
+	McCluskeyLayerInfo_t * info;
 	size_t cap_set, n_set;
+	// Number of cover layers on top of the layers of prime implicants
+	size_t n_covers;
+
+	// Scratch memory of layer generation, kept between problems
+	McCluskeyVals_t scratch;
+	uint64_t * connected;
+	size_t cap_connected;
+
+	// Rows of the first layer edited since the last update, with their outputs
+	// before the first edit
+	McCluskeyVals_t edits;
+	// Whether the first layer has been indexed and checked for duplicate rows
+	bool editable;
+	// Whether the layers below the cover layers are the solved layers, false after
+	// loading prime implicants with McCluskeySolver_loadPrimes or dropping consumed
+	// layers in low-memory mode
+	bool layered;
+	// Whether the cover search ran out of its budget, the cover layers are then not
+	// proven minimum
+	bool expired;
+
+	// Counters, layer nodes and index probes are filled in by McCluskeySolver_getStats
+	McCluskeyStats_t stats;
+
+	// Options are read from the context on every call
+	const McCluskeyCtx_t * ctx;
 
 } McCluskeySolver_t;
 
 ///
 ///	@brief Creates a solver object from source data
 ///	@param This Pointer to destination object
+///	@param ctx Pointer to context, must outlive the object and be shared by the
+///	source data
 ///	@param source Pointer to source node
 ///	@returns Whether the operation was successful
 ///
-bool McCluskeySolver_make(McCluskeySolver_t * restrict This, McCluskeyVals_t * restrict source);
+bool McCluskeySolver_make(McCluskeySolver_t * restrict This, const McCluskeyCtx_t * restrict ctx, McCluskeyVals_t * restrict source);
+///
+///	@brief Prepares the solver for a new problem, keeps the settings and the
+///	memory of all layers
+///	@param This Pointer to the solver object
+///	@param source Pointer to source node, receives the emptied memory of the
+///	previous first layer
+///	@returns Whether the operation was successful
+///
+bool McCluskeySolver_reset(McCluskeySolver_t * restrict This, McCluskeyVals_t * restrict source);
 ///
 ///	@brief Creates a new layer for solving the problem
 ///	@param This Pointer to the object
@@ -283,13 +738,20 @@ bool McCluskeySolver_popLayer(McCluskeySolver_t * restrict This);
 void McCluskeySolver_destroy(McCluskeySolver_t * restrict This);
 
 ///
-///	@brief Solve one layer
+///	@brief Solve one layer. 2 nodes are merged if they are implicants of a common
+///	output, the merged node is an implicant of the outputs common to both. A node
+///	is carried over to the next layer unless it was merged into a node of all of
+///	its outputs. In low-memory mode the new layer replaces the previous layer
 ///	@param This Pointer to the solver object
+///	@param newNodes Pointer to variable receiving whether the layer produced any new
+///	nodes, layers are solved until it is false. Always false for the Espresso engine,
+///	which adds no layer
 ///	@returns Whether the operation was successful
 ///
-bool McCluskeySolver_solveLayer(McCluskeySolver_t * restrict This);
+bool McCluskeySolver_solveLayer(McCluskeySolver_t * restrict This, bool * restrict newNodes);
 ///
-///	@brief Optimise one layer
+///	@brief Optimise one layer, finds the covers with the least product terms which
+///	cover the '1' of every output
 ///	@param This Pointer to the solver object
 ///	@param newLayers Pointer to variable that denotes the number of new layers added
 ///	which are all optimal
@@ -298,102 +760,79 @@ bool McCluskeySolver_solveLayer(McCluskeySolver_t * restrict This);
 bool McCluskeySolver_optimiseLayer(McCluskeySolver_t * restrict This, size_t * restrict newLayers);
 ///
 ///	@param This Pointer to the solver object
-///	@returns Pointer to the current layer, NULL if no layers
-///
-McCluskeyVals_t * McCluskeySolver_getLayer(McCluskeySolver_t * restrict This);
-
-///
-///	@brief A node data structure for MCHashSet_t
-///
-typedef struct MCHashSetNode MCHashSetNode_t;
-
-///
-///	@param This Pointer to hash-set node
-///	@returns Pointer to data of hash-set node if applicable
-///
-void * MCHashSetNode_getData(MCHashSetNode_t * restrict This);
-///
-///	@param This Pointer to hash-set node
-///	@returns Pointer to data of hash-set node if applicable
-///
-const void * MCHashSetNode_getConstData(const MCHashSetNode_t * restrict This);
-
+///	@returns Whether the cover search of the last optimisation ran out of its budget,
+///	its covers are then the smallest found but not proven minimum. Always false for
+///	the Espresso engine, which has no budget
 ///
-///	@brief A hash-set to hold McCluskey intervals
+bool McCluskeySolver_isExpired(const McCluskeySolver_t * restrict This);
 ///
-typedef struct MCHashSet
-{
-	MCHashSetNode_t ** nodes;
-	size_t n_nodes, n_elems;
-
-} MCHashSet_t;
-
-///
-///	@brief Creates MCHashSet_t object
-///	@param This Pointer to object
-///	@param defSize default size of hash-set
+///	@brief Adds the '1' and '-' outputs of a node to the row of the first layer with
+///	the same argument vector, the row is added if there is none. Takes effect with
+///	McCluskeySolver_update
+///	@param This Pointer to the solver object
+///	@param val Pointer to node
 ///	@returns Whether the operation was successful
 ///
-bool MCHashSet_make(MCHashSet_t * restrict This, size_t defSize);
-///
-///	@returns Whether the given number is prime
-///
-bool MCHashSet_isPrime(size_t num);
-///
-///	@returns Next prime number including lowerBound, if lowerBound is prime already
-///
-size_t MCHashSet_findNextPrime(size_t lowerBound);
-///
-///	@brief Resizes hash-set
-///	@param This Pointer to hash-set
-///	@param size New minimum size
-///	@returns Whether resizing was successful
-///
-bool MCHashSet_resize(MCHashSet_t * restrict This, size_t size);
+bool McCluskeySolver_addRow(McCluskeySolver_t * restrict This, const McCluskeyVal_t * restrict val);
 ///
-///	@brief Inserts an element to hash-set
-///	@param This Pointer to hash-set
-///	@param key Insertable key
-///	@returns Pointer to inserted object, Pointer to previous object if was inserted
-///	already, NULL if insertion wasn't successful
+///	@brief Removes the outputs a node has as '1' or '-' from the row of the first
+///	layer with the same argument vector. A row left without outputs stays in the
+///	first layer, so that parent indices remain valid, but takes no further part.
+///	Takes effect with McCluskeySolver_update
+///	@param This Pointer to the solver object
+///	@param val Pointer to node
+///	@returns Whether the operation was successful
 ///
-MCHashSetNode_t * MCHashSet_push(MCHashSet_t * restrict This, uint64_t key);
+bool McCluskeySolver_removeRow(McCluskeySolver_t * restrict This, const McCluskeyVal_t * restrict val);
 ///
-///	@brief Removes an element from hash-set
-///	@param This Pointer to hash-set
-///	@param key Removable key
-///	@returns Whether the key was found & removed from hash-set
+///	@brief Updates the solved layers after edits of rows and optimises again,
+///	replacing the cover layers. Only the nodes of each layer next to changed nodes
+///	of the previous layer are recomputed, layers are added or dropped as the last
+///	layer of prime implicants moves. The cover search starts with the size of the
+///	previous cover completed greedily as its bound. Updated layers are no longer
+///	sorted. The Espresso engine minimises the first layer again
+///	@param This Pointer to the solver object
+///	@param newLayers Pointer to variable that denotes the number of new cover layers
+///	@returns Whether the operation was successful
 ///
-bool MCHashSet_pop(MCHashSet_t * restrict This, uint64_t key);
+bool McCluskeySolver_update(McCluskeySolver_t * restrict This, size_t * restrict newLayers);
 ///
-///	@param This Pointer to hash-set
-///	@param key Key to be searched
-///	@returns Whether the key was found in hash-set
+///	@brief Replaces the layers above the first layer with 1 layer of given prime
+///	implicants, such as results loaded from a cache. The parents of an implicant
+///	are the defined rows of the first layer it contains at all of its outputs.
+///	McCluskeySolver_update solves the edited first layer from scratch afterwards
+///	@param This Pointer to the solver object
+///	@param primes Array of prime implicants
+///	@param n_primes Number of prime implicants
+///	@returns Whether the operation was successful
 ///
-bool MCHashSet_exists(const MCHashSet_t * restrict This, uint64_t key);
+bool McCluskeySolver_loadPrimes(McCluskeySolver_t * restrict This, const McCluskeyVal_t * restrict primes, size_t n_primes);
 ///
-///	@brief Searches for node with given key
-///	@param This Pointer to hash-set
-///	@param key Key to be searched
-///	@returns Pointer to found node, NULL if object was not found
+///	@brief Adds a cover layer on top of the layer of prime implicants loaded with
+///	McCluskeySolver_loadPrimes
+///	@param This Pointer to the solver object
+///	@param terms Indices of the nodes of the cover in the layer of prime implicants
+///	@param n_terms Number of nodes in the cover
+///	@returns Whether the operation was successful
 ///
-MCHashSetNode_t * MCHashSet_get(MCHashSet_t * restrict This, uint64_t key);
+bool McCluskeySolver_loadCover(McCluskeySolver_t * restrict This, const uint32_t * restrict terms, size_t n_terms);
 ///
-///	@returns Element count in hash-set
+///	@param This Pointer to the solver object
+///	@returns Pointer to the current layer, NULL if no layers
 ///
-size_t MCHashSet_getCount(const MCHashSet_t * restrict This);
+McCluskeyVals_t * McCluskeySolver_getLayer(McCluskeySolver_t * restrict This);
 ///
-///	@brief Fills given array with hash-set elements
-///	@param This Pointer to hash-set
-///	@param array Given hash-set node array
-///	@param arrMax Maximum array size
-///	@returns true if array was big enough to be filled, false if array was too small
+///	@param This Pointer to the solver object
+///	@returns Pointer to the first layer which all parent indices refer to, NULL if
+///	no layers
 ///
-bool MCHashSet_getArr(MCHashSet_t * restrict This, MCHashSetNode_t ** array, size_t arrMax);
+McCluskeyVals_t * McCluskeySolver_getBaseLayer(McCluskeySolver_t * restrict This);
 ///
-///	@brief Destroys hash-set
-///	@param This Pointer to hash-set
+///	@brief Gathers the algorithmic counters of the solver. The node counts and hash
+///	index probe lengths are measured from the current layers
+///	@param This Pointer to the solver object
+///	@param stats Pointer to structure receiving the counters
 ///
-void MCHashSet_destroy(MCHashSet_t * restrict This);
+void McCluskeySolver_getStats(const McCluskeySolver_t * restrict This, McCluskeyStats_t * restrict stats);
 
 #endif
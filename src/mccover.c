@@ -0,0 +1,1049 @@
+#include "mccover.h"
+#include "mcpool.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+///
+///	@returns Pointer to uncovered minterm bitset at given depth of selection
+///
+static inline uint64_t * McCluskeyCover_uncoveredAt(McCluskeyCover_t * restrict This, size_t depth)
+{
+	return &This->uncovered[This->n_words * depth];
+}
+
+bool McCluskeyCover_make(
+	McCluskeyCover_t * restrict This,
+	const McCluskeyVals_t * restrict primes,
+	const McCluskeyVals_t * restrict base
+)
+{
+	memset(This, 0, sizeof(McCluskeyCover_t));
+	This->n_primes   = primes->n_vals;
+	This->best       = SIZE_MAX;
+	This->upperBound = SIZE_MAX;
+
+	// Outputs of a base node are numbered from termOff[node] on
+	size_t * termOff = malloc(sizeof(size_t) * (base->n_vals + 1));
+	if (termOff == NULL)
+	{
+		return false;
+	}
+	termOff[0] = 0;
+	for (size_t i = 0; i < base->n_vals; ++i)
+	{
+		termOff[i + 1] = termOff[i] + (size_t)__builtin_popcount(base->onTags[i]);
+	}
+
+	size_t n_entries = 0;
+	for (size_t i = 0; i < This->n_primes; ++i)
+	{
+		const McCluskeyTag_t tag = primes->onTags[i] | primes->dcTags[i];
+		uint32_t n_parents;
+		const uint32_t * parents = McCluskeyVals_getParents(primes, i, &n_parents);
+		for (uint32_t j = 0; j < n_parents; ++j)
+		{
+			n_entries += (size_t)__builtin_popcount(tag & base->onTags[parents[j]]);
+		}
+	}
+
+	// 1 extra element everywhere, so that empty problems allocate too
+	uint32_t * ids      = malloc(sizeof(uint32_t) * (termOff[base->n_vals] + 1));
+	This->primeOff      = malloc(sizeof(size_t)   * (This->n_primes + 1));
+	This->primeMinterms = malloc(sizeof(uint32_t) * (n_entries + 1));
+	This->banned        = calloc(This->n_primes + 1, sizeof(bool));
+	This->bans          = malloc(sizeof(uint32_t) * (This->n_primes + 1));
+	This->stamps        = calloc(This->n_primes + 1, sizeof(uint32_t));
+	This->selected      = malloc(sizeof(uint32_t) * (This->n_primes + 1));
+	if (ids == NULL || This->primeOff == NULL || This->primeMinterms == NULL ||
+		This->banned == NULL || This->bans == NULL || This->stamps == NULL || This->selected == NULL)
+	{
+		free(ids);
+		free(termOff);
+		McCluskeyCover_destroy(This);
+		return false;
+	}
+
+	// Renumber minterms densely in order of appearance, a prime covers the '1' of
+	// its parents at each of its outputs
+	memset(ids, 0xFF, sizeof(uint32_t) * (termOff[base->n_vals] + 1));
+	size_t k = 0;
+	for (size_t i = 0; i < This->n_primes; ++i)
+	{
+		This->primeOff[i] = k;
+		const McCluskeyTag_t tag = primes->onTags[i] | primes->dcTags[i];
+		uint32_t n_parents;
+		const uint32_t * parents = McCluskeyVals_getParents(primes, i, &n_parents);
+		for (uint32_t j = 0; j < n_parents; ++j)
+		{
+			const McCluskeyTag_t onTag = base->onTags[parents[j]];
+			for (McCluskeyTag_t outs = tag & onTag; outs != 0; outs &= outs - 1)
+			{
+				const McCluskeyTag_t bit = outs & (~outs + 1);
+				const size_t id = termOff[parents[j]] + (size_t)__builtin_popcount(onTag & (bit - 1));
+				if (ids[id] == UINT32_MAX)
+				{
+					ids[id] = (uint32_t)This->n_minterms;
+					++This->n_minterms;
+				}
+				This->primeMinterms[k] = ids[id];
+				++k;
+			}
+		}
+	}
+	This->primeOff[This->n_primes] = k;
+	free(ids);
+	free(termOff);
+
+	This->n_words       = (This->n_minterms + 63) / 64;
+	This->cap_depth     = 1;
+	This->mintermOff    = calloc(This->n_minterms + 2, sizeof(size_t));
+	This->mintermPrimes = malloc(sizeof(uint32_t) * (n_entries + 1));
+	This->avail         = malloc(sizeof(uint32_t) * (This->n_minterms + 1));
+	This->rows          = calloc(This->n_primes * This->n_words + 1, sizeof(uint64_t));
+	This->uncovered     = calloc(This->n_words + 1, sizeof(uint64_t));
+	This->n_uncovered   = malloc(sizeof(size_t));
+	if (This->mintermOff == NULL || This->mintermPrimes == NULL || This->avail == NULL ||
+		This->rows == NULL || This->uncovered == NULL || This->n_uncovered == NULL)
+	{
+		McCluskeyCover_destroy(This);
+		return false;
+	}
+
+	// Fill the incidence matrix and transpose it
+	for (size_t i = 0; i < This->n_primes; ++i)
+	{
+		uint64_t * row = &This->rows[This->n_words * i];
+		for (size_t j = This->primeOff[i]; j < This->primeOff[i + 1]; ++j)
+		{
+			const uint32_t m = This->primeMinterms[j];
+			row[m / 64] |= (uint64_t)1 << (m % 64);
+			++This->mintermOff[m + 2];
+		}
+	}
+	for (size_t i = 2; i < (This->n_minterms + 2); ++i)
+	{
+		This->mintermOff[i] += This->mintermOff[i - 1];
+	}
+	for (size_t i = 0; i < This->n_primes; ++i)
+	{
+		for (size_t j = This->primeOff[i]; j < This->primeOff[i + 1]; ++j)
+		{
+			This->mintermPrimes[This->mintermOff[This->primeMinterms[j] + 1]++] = (uint32_t)i;
+		}
+	}
+
+	for (size_t i = 0; i < This->n_minterms; ++i)
+	{
+		uint32_t * list = &This->mintermPrimes[This->mintermOff[i]];
+		const size_t n = This->mintermOff[i + 1] - This->mintermOff[i];
+		This->avail[i] = (uint32_t)n;
+		This->uncovered[i / 64] |= (uint64_t)1 << (i % 64);
+
+		// Try primes covering more minterms first, good covers are found early
+		for (size_t j = 1; j < n; ++j)
+		{
+			const uint32_t p = list[j];
+			const size_t size = This->primeOff[p + 1] - This->primeOff[p];
+			size_t l = j;
+			for (; l > 0 && (This->primeOff[list[l - 1] + 1] - This->primeOff[list[l - 1]]) < size; --l)
+			{
+				list[l] = list[l - 1];
+			}
+			list[l] = p;
+		}
+	}
+	This->n_uncovered[0] = This->n_minterms;
+
+	return true;
+}
+
+///
+///	@brief Adds prime to the current selection, uncovered minterms of the next depth
+///	are the uncovered minterms of the current depth without the row of the prime
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCover_select(McCluskeyCover_t * restrict This, uint32_t prime)
+{
+	const size_t depth = This->n_selected;
+	if ((depth + 2) > This->cap_depth)
+	{
+		const size_t newcap = (depth + 2) * 2;
+		uint64_t * newUncovered = realloc(This->uncovered, sizeof(uint64_t) * (This->n_words * newcap + 1));
+		if (newUncovered == NULL)
+		{
+			return false;
+		}
+		This->uncovered = newUncovered;
+		size_t * newCounts = realloc(This->n_uncovered, sizeof(size_t) * newcap);
+		if (newCounts == NULL)
+		{
+			return false;
+		}
+		This->n_uncovered = newCounts;
+		This->cap_depth   = newcap;
+	}
+
+	const uint64_t * restrict row = &This->rows[This->n_words * prime];
+	const uint64_t * restrict src = McCluskeyCover_uncoveredAt(This, depth);
+	uint64_t * restrict dst = McCluskeyCover_uncoveredAt(This, depth + 1);
+	size_t n_covered = 0;
+	for (size_t i = 0; i < This->n_words; ++i)
+	{
+		n_covered += (size_t)__builtin_popcountll(src[i] & row[i]);
+		dst[i] = src[i] & ~row[i];
+	}
+	This->n_uncovered[depth + 1] = This->n_uncovered[depth] - n_covered;
+
+	This->selected[depth] = prime;
+	++This->n_selected;
+	return true;
+}
+///
+///	@brief Excludes prime from the rest of the current subtree
+///
+static inline void McCluskeyCover_ban(McCluskeyCover_t * restrict This, uint32_t prime)
+{
+	This->banned[prime] = true;
+	This->bans[This->n_bans] = prime;
+	++This->n_bans;
+	for (size_t i = This->primeOff[prime]; i < This->primeOff[prime + 1]; ++i)
+	{
+		--This->avail[This->primeMinterms[i]];
+	}
+}
+///
+///	@brief Lifts all exclusions made after n_bans
+///
+static inline void McCluskeyCover_unban(McCluskeyCover_t * restrict This, size_t n_bans)
+{
+	while (This->n_bans > n_bans)
+	{
+		--This->n_bans;
+		const uint32_t prime = This->bans[This->n_bans];
+		This->banned[prime] = false;
+		for (size_t i = This->primeOff[prime]; i < This->primeOff[prime + 1]; ++i)
+		{
+			++This->avail[This->primeMinterms[i]];
+		}
+	}
+}
+///
+///	@brief Lower bound of primes still needed: uncovered minterms sharing no
+///	available prime with each other need a distinct prime each
+///
+static inline size_t McCluskeyCover_lowerBound(McCluskeyCover_t * restrict This)
+{
+	++This->stamp;
+	if (This->stamp == 0)
+	{
+		memset(This->stamps, 0, sizeof(uint32_t) * This->n_primes);
+		This->stamp = 1;
+	}
+
+	const uint64_t * uncovered = McCluskeyCover_uncoveredAt(This, This->n_selected);
+	size_t bound = 0;
+	for (size_t w = 0; w < This->n_words; ++w)
+	{
+		for (uint64_t bits = uncovered[w]; bits != 0; bits &= bits - 1)
+		{
+			const size_t i = w * 64 + (size_t)__builtin_ctzll(bits);
+			const uint32_t * list = &This->mintermPrimes[This->mintermOff[i]];
+			const size_t n = This->mintermOff[i + 1] - This->mintermOff[i];
+			bool independent = true;
+			for (size_t j = 0; independent && j < n; ++j)
+			{
+				independent = This->banned[list[j]] || This->stamps[list[j]] != This->stamp;
+			}
+			if (independent)
+			{
+				++bound;
+				for (size_t j = 0; j < n; ++j)
+				{
+					This->stamps[list[j]] = This->stamp;
+				}
+			}
+		}
+	}
+	return bound;
+}
+///
+///	@returns Size of the best cover found by this or any other worker
+///
+static inline size_t McCluskeyCover_bound(const McCluskeyCover_t * restrict This)
+{
+	size_t best = This->best;
+	if (This->sharedBest != NULL)
+	{
+		const size_t shared = atomic_load_explicit(This->sharedBest, memory_order_relaxed);
+		best = (shared < best) ? shared : best;
+	}
+	return best;
+}
+///
+///	@returns Current time in seconds
+///
+static inline double McCluskeyCover_now(void)
+{
+	struct timespec ts;
+	if (timespec_get(&ts, TIME_UTC) == 0)
+	{
+		return 0.0;
+	}
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+///
+///	@brief Counts a visited search tree node against the budget. A single search
+///	checks the node budget on every node, the workers of a parallel search add
+///	their nodes to the shared count every MCCLUSKEYCOVER_BUDGET_INTERVAL nodes. The
+///	time is checked every MCCLUSKEYCOVER_BUDGET_INTERVAL nodes
+///	@returns Whether the budget has run out for this or any other worker
+///
+static inline bool McCluskeyCover_expire(McCluskeyCover_t * restrict This)
+{
+	if (This->expired || (This->nodeBudget == 0 && This->deadline <= 0.0))
+	{
+		return This->expired;
+	}
+	++This->n_spent;
+	const bool check = (This->n_spent % MCCLUSKEYCOVER_BUDGET_INTERVAL) == 0;
+
+	uint64_t n_spent = This->n_spent;
+	if (This->sharedSpent != NULL && !check)
+	{
+		return false;
+	}
+	else if (This->sharedSpent != NULL)
+	{
+		n_spent = atomic_fetch_add_explicit(This->sharedSpent, MCCLUSKEYCOVER_BUDGET_INTERVAL, memory_order_relaxed) +
+			MCCLUSKEYCOVER_BUDGET_INTERVAL;
+		This->expired = atomic_load_explicit(This->sharedExpired, memory_order_relaxed);
+	}
+	if ((This->nodeBudget > 0 && n_spent >= This->nodeBudget) ||
+		(check && This->deadline > 0.0 && McCluskeyCover_now() >= This->deadline))
+	{
+		This->expired = true;
+	}
+	if (This->expired && This->sharedExpired != NULL)
+	{
+		atomic_store_explicit(This->sharedExpired, true, memory_order_relaxed);
+	}
+	return This->expired;
+}
+///
+///	@brief Records the current selection as a cover with ascending primes, covers are
+///	appended in the order found and sorted by McCluskeyCover_sort
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCover_record(McCluskeyCover_t * restrict This)
+{
+	MCCLUSKEY_STAT(++This->n_recorded);
+	if (This->n_selected > McCluskeyCover_bound(This))
+	{
+		return true;
+	}
+	else if (This->sharedBest != NULL)
+	{
+		size_t shared = atomic_load(This->sharedBest);
+		while (This->n_selected < shared &&
+			!atomic_compare_exchange_weak(This->sharedBest, &shared, This->n_selected));
+	}
+
+	if (This->n_selected < This->best)
+	{
+		This->best        = This->n_selected;
+		This->n_solutions = 0;
+	}
+
+	const size_t width = This->best;
+	if ((This->n_solutions + 1) > This->cap_solutions)
+	{
+		const size_t newcap = (This->n_solutions + 1) * 2;
+		uint32_t * mem = realloc(This->solutions, sizeof(uint32_t) * (width * newcap + 1));
+		if (mem == NULL)
+		{
+			return false;
+		}
+		This->solutions     = mem;
+		This->cap_solutions = newcap;
+	}
+
+	uint32_t * row = &This->solutions[width * This->n_solutions];
+	for (size_t i = 0; i < width; ++i)
+	{
+		const uint32_t p = This->selected[i];
+		size_t j = i;
+		for (; j > 0 && row[j - 1] > p; --j)
+		{
+			row[j] = row[j - 1];
+		}
+		row[j] = p;
+	}
+	++This->n_solutions;
+
+	return true;
+}
+///
+///	@brief Picks the uncovered minterm with fewest available primes to branch on
+///	@param minterm Pointer receiving the minterm
+///	@returns Number of available primes of the minterm
+///
+static inline uint32_t McCluskeyCover_pick(const McCluskeyCover_t * restrict This, size_t * restrict minterm)
+{
+	const uint64_t * uncovered = &This->uncovered[This->n_words * This->n_selected];
+	uint32_t fewest = UINT32_MAX;
+	*minterm = 0;
+	for (size_t w = 0; w < This->n_words; ++w)
+	{
+		for (uint64_t bits = uncovered[w]; bits != 0; bits &= bits - 1)
+		{
+			const size_t i = w * 64 + (size_t)__builtin_ctzll(bits);
+			if (This->avail[i] < fewest)
+			{
+				*minterm = i;
+				fewest   = This->avail[i];
+			}
+		}
+	}
+	return fewest;
+}
+///
+///	@brief Branches on the uncovered minterm with fewest available primes
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyCover_search(McCluskeyCover_t * restrict This)
+{
+	MCCLUSKEY_STAT(++This->n_visited);
+	const bool expired = McCluskeyCover_expire(This);
+	if (This->n_uncovered[This->n_selected] == 0)
+	{
+		return McCluskeyCover_record(This);
+	}
+	else if ((This->n_selected + 1) > McCluskeyCover_bound(This) || expired)
+	{
+		return true;
+	}
+
+	size_t minterm;
+	const uint32_t fewest = McCluskeyCover_pick(This, &minterm);
+	if (fewest == 0 || (This->n_selected + McCluskeyCover_lowerBound(This)) > McCluskeyCover_bound(This))
+	{
+		return true;
+	}
+
+	const size_t n_bans = This->n_bans;
+	bool success = true;
+	for (size_t i = This->mintermOff[minterm]; success && i < This->mintermOff[minterm + 1]; ++i)
+	{
+		const uint32_t prime = This->mintermPrimes[i];
+		if (This->banned[prime])
+		{
+			continue;
+		}
+
+		if (McCluskeyCover_select(This, prime) == false)
+		{
+			success = false;
+			break;
+		}
+		success = McCluskeyCover_search(This);
+		--This->n_selected;
+
+		// Covers containing this prime have been visited
+		McCluskeyCover_ban(This, prime);
+		if ((This->n_selected + 1) > McCluskeyCover_bound(This) || This->expired)
+		{
+			break;
+		}
+	}
+	McCluskeyCover_unban(This, n_bans);
+
+	return success;
+}
+///
+///	@brief Fixes essential primes and drops primes left without uncovered minterms,
+///	repeated until nothing changes
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCover_reduce(McCluskeyCover_t * restrict This)
+{
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (size_t i = 0; i < This->n_minterms; ++i)
+		{
+			const uint64_t * uncovered = McCluskeyCover_uncoveredAt(This, This->n_selected);
+			if (((uncovered[i / 64] >> (i % 64)) & 1) == 0 || This->avail[i] != 1)
+			{
+				continue;
+			}
+			for (size_t j = This->mintermOff[i]; j < This->mintermOff[i + 1]; ++j)
+			{
+				const uint32_t prime = This->mintermPrimes[j];
+				if (!This->banned[prime])
+				{
+					if (McCluskeyCover_select(This, prime) == false)
+					{
+						return false;
+					}
+					++This->n_essential;
+					changed = true;
+					break;
+				}
+			}
+		}
+
+		// Primes covering only covered minterms are redundant in a minimum cover
+		const uint64_t * uncovered = McCluskeyCover_uncoveredAt(This, This->n_selected);
+		for (uint32_t p = 0; p < This->n_primes; ++p)
+		{
+			if (This->banned[p])
+			{
+				continue;
+			}
+			const uint64_t * row = &This->rows[This->n_words * p];
+			bool redundant = true;
+			for (size_t w = 0; redundant && w < This->n_words; ++w)
+			{
+				redundant = (row[w] & uncovered[w]) == 0;
+			}
+			if (redundant)
+			{
+				McCluskeyCover_ban(This, p);
+				changed = true;
+			}
+		}
+	}
+
+	return true;
+}
+
+///
+///	@brief Number of decisions after which subtrees are searched without splitting,
+///	a task stores its depth and the branch taken at every decision
+///
+#define MCCLUSKEYCOVER_SPLIT_DEPTH (MCPOOLTASK_NUM_ARGS - 1)
+///
+///	@brief Number of initial tasks per thread
+///
+#define MCCLUSKEYCOVER_TASKS_PER_THREAD 8
+
+///
+///	@brief Data shared by workers of the parallel search
+///
+typedef struct McCluskeyCoverJob
+{
+	// Worker copies of the search state
+	McCluskeyCover_t * workers;
+	// Buffer of child tasks for each worker
+	MCPoolTask_t * children;
+	size_t n_branches;
+	size_t n_selected, n_bans;
+
+} McCluskeyCoverJob_t;
+
+///
+///	@brief Creates a worker copy of the search state, sharing the incidence
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCover_clone(McCluskeyCover_t * restrict This, const McCluskeyCover_t * restrict src)
+{
+	*This = *src;
+	This->avail       = malloc(sizeof(uint32_t) * (src->n_minterms + 1));
+	This->banned      = malloc(sizeof(bool)     * (src->n_primes + 1));
+	This->bans        = malloc(sizeof(uint32_t) * (src->n_primes + 1));
+	This->stamps      = calloc(src->n_primes + 1, sizeof(uint32_t));
+	This->selected    = malloc(sizeof(uint32_t) * (src->n_primes + 1));
+	This->uncovered   = malloc(sizeof(uint64_t) * (src->n_words * src->cap_depth + 1));
+	This->n_uncovered = malloc(sizeof(size_t)   * src->cap_depth);
+	This->stamp         = 0;
+	This->solutions     = NULL;
+	This->n_solutions   = 0;
+	This->cap_solutions = 0;
+	This->n_visited     = 0;
+	This->n_recorded    = 0;
+	This->n_spent       = 0;
+	if (This->avail == NULL || This->banned == NULL || This->bans == NULL || This->stamps == NULL ||
+		This->selected == NULL || This->uncovered == NULL || This->n_uncovered == NULL)
+	{
+		return false;
+	}
+
+	memcpy(This->avail,       src->avail,       sizeof(uint32_t) * src->n_minterms);
+	memcpy(This->banned,      src->banned,      sizeof(bool)     * src->n_primes);
+	memcpy(This->bans,        src->bans,        sizeof(uint32_t) * src->n_bans);
+	memcpy(This->selected,    src->selected,    sizeof(uint32_t) * src->n_selected);
+	memcpy(This->uncovered,   src->uncovered,   sizeof(uint64_t) * src->n_words * (src->n_selected + 1));
+	memcpy(This->n_uncovered, src->n_uncovered, sizeof(size_t)   * (src->n_selected + 1));
+	return true;
+}
+///
+///	@brief Frees the worker copy of the search state
+///
+static inline void McCluskeyCover_destroyClone(McCluskeyCover_t * restrict This)
+{
+	free(This->avail);
+	free(This->banned);
+	free(This->bans);
+	free(This->stamps);
+	free(This->selected);
+	free(This->uncovered);
+	free(This->n_uncovered);
+	free(This->solutions);
+}
+///
+///	@brief Repeats the decisions of a task from the root of the search
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCover_replay(McCluskeyCover_t * restrict This, const MCPoolTask_t * restrict task)
+{
+	for (size_t d = 0; d < task->args[0]; ++d)
+	{
+		size_t minterm;
+		McCluskeyCover_pick(This, &minterm);
+		const size_t branch = This->mintermOff[minterm] + task->args[d + 1];
+
+		// Earlier branches of the decision have been visited by other tasks
+		for (size_t i = This->mintermOff[minterm]; i < branch; ++i)
+		{
+			if (!This->banned[This->mintermPrimes[i]])
+			{
+				McCluskeyCover_ban(This, This->mintermPrimes[i]);
+			}
+		}
+		if (McCluskeyCover_select(This, This->mintermPrimes[branch]) == false)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+///
+///	@brief Lists the child tasks of a task, records its selection if it is a cover
+///	@param children Array receiving the child tasks, 1 element per branch
+///	@param n_children Pointer receiving the number of child tasks
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCover_expand(
+	McCluskeyCover_t * restrict This,
+	const MCPoolTask_t * restrict task,
+	MCPoolTask_t * restrict children,
+	size_t * restrict n_children
+)
+{
+	const size_t n_selected = This->n_selected, n_bans = This->n_bans;
+	*n_children = 0;
+
+	bool success = McCluskeyCover_replay(This, task);
+	size_t minterm;
+	MCCLUSKEY_STAT(++This->n_visited);
+	const bool expired = McCluskeyCover_expire(This);
+	if (!success)
+	{
+	}
+	else if (This->n_uncovered[This->n_selected] == 0)
+	{
+		success = McCluskeyCover_record(This);
+	}
+	else if ((This->n_selected + 1) <= McCluskeyCover_bound(This) && !expired &&
+		McCluskeyCover_pick(This, &minterm) > 0 &&
+		(This->n_selected + McCluskeyCover_lowerBound(This)) <= McCluskeyCover_bound(This))
+	{
+		for (size_t i = This->mintermOff[minterm]; i < This->mintermOff[minterm + 1]; ++i)
+		{
+			if (!This->banned[This->mintermPrimes[i]])
+			{
+				MCPoolTask_t * child = &children[*n_children];
+				*child = *task;
+				child->args[task->args[0] + 1] = i - This->mintermOff[minterm];
+				++child->args[0];
+				++*n_children;
+			}
+		}
+	}
+
+	This->n_selected = n_selected;
+	McCluskeyCover_unban(This, n_bans);
+	return success;
+}
+///
+///	@brief Work function of the parallel search, splits shallow tasks further and
+///	searches the subtrees of deep tasks
+///
+static bool McCluskeyCover_task(MCPool_t * pool, size_t worker, const MCPoolTask_t * task, void * user)
+{
+	McCluskeyCoverJob_t * job = user;
+	McCluskeyCover_t * This   = &job->workers[worker];
+
+	if (task->args[0] < MCCLUSKEYCOVER_SPLIT_DEPTH)
+	{
+		MCPoolTask_t * children = &job->children[worker * job->n_branches];
+		size_t n_children;
+		bool success = McCluskeyCover_expand(This, task, children, &n_children);
+		// Last child first, own queue is worked on from the back
+		for (size_t i = n_children; success && i > 0; --i)
+		{
+			success = MCPool_push(pool, worker, &children[i - 1]);
+		}
+		return success;
+	}
+
+	bool success = McCluskeyCover_replay(This, task) && McCluskeyCover_search(This);
+	This->n_selected = job->n_selected;
+	McCluskeyCover_unban(This, job->n_bans);
+	return success;
+}
+///
+///	@brief Appends the covers found by a worker to the result
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCover_merge(McCluskeyCover_t * restrict This, const McCluskeyCover_t * restrict worker)
+{
+	if (worker->n_solutions == 0 || worker->best != This->best)
+	{
+		return true;
+	}
+
+	const size_t width = This->best, n_solutions = This->n_solutions + worker->n_solutions;
+	if (n_solutions > This->cap_solutions)
+	{
+		uint32_t * mem = realloc(This->solutions, sizeof(uint32_t) * (width * n_solutions + 1));
+		if (mem == NULL)
+		{
+			return false;
+		}
+		This->solutions     = mem;
+		This->cap_solutions = n_solutions;
+	}
+
+	memcpy(&This->solutions[width * This->n_solutions], worker->solutions, sizeof(uint32_t) * width * worker->n_solutions);
+	This->n_solutions = n_solutions;
+	return true;
+}
+///
+///	@brief Key of 1 cover for sorting
+///
+typedef struct McCluskeyCoverRow
+{
+	const uint32_t * primes;
+	size_t width;
+
+} McCluskeyCoverRow_t;
+
+///
+///	@brief Compares covers lexicographically by their ascending primes
+///
+static int McCluskeyCover_cmpRows(const void * a, const void * b)
+{
+	const McCluskeyCoverRow_t * rowA = a, * rowB = b;
+	for (size_t i = 0; i < rowA->width; ++i)
+	{
+		if (rowA->primes[i] != rowB->primes[i])
+		{
+			return (rowA->primes[i] < rowB->primes[i]) ? -1 : 1;
+		}
+	}
+	return 0;
+}
+///
+///	@brief Orders the covers found lexicographically
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCover_sort(McCluskeyCover_t * restrict This)
+{
+	if (This->n_solutions < 2)
+	{
+		return true;
+	}
+
+	const size_t width = This->best;
+	McCluskeyCoverRow_t * rows = malloc(sizeof(McCluskeyCoverRow_t) * This->n_solutions);
+	uint32_t * sorted = malloc(sizeof(uint32_t) * (width * This->n_solutions + 1));
+	if (rows == NULL || sorted == NULL)
+	{
+		free(rows);
+		free(sorted);
+		return false;
+	}
+
+	for (size_t i = 0; i < This->n_solutions; ++i)
+	{
+		rows[i] = (McCluskeyCoverRow_t){ .primes = &This->solutions[width * i], .width = width };
+	}
+	qsort(rows, This->n_solutions, sizeof(McCluskeyCoverRow_t), &McCluskeyCover_cmpRows);
+	for (size_t i = 0; i < This->n_solutions; ++i)
+	{
+		memcpy(&sorted[width * i], rows[i].primes, sizeof(uint32_t) * width);
+	}
+	free(rows);
+
+	free(This->solutions);
+	This->solutions     = sorted;
+	This->cap_solutions = This->n_solutions;
+	return true;
+}
+///
+///	@brief Searches the subtrees of the first decisions on a work-stealing pool
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyCover_searchParallel(McCluskeyCover_t * restrict This, size_t n_threads)
+{
+	atomic_size_t sharedBest;
+	atomic_init(&sharedBest, This->best);
+	This->sharedBest = &sharedBest;
+	atomic_uint_fast64_t sharedSpent;
+	atomic_init(&sharedSpent, This->n_spent);
+	atomic_bool sharedExpired;
+	atomic_init(&sharedExpired, false);
+
+	// Most branches a decision can have
+	size_t n_branches = 1;
+	for (size_t i = 0; i < This->n_minterms; ++i)
+	{
+		const size_t n = This->mintermOff[i + 1] - This->mintermOff[i];
+		n_branches = (n > n_branches) ? n : n_branches;
+	}
+
+	// Split the first decisions until every thread has enough tasks
+	MCPoolTask_t * tasks = calloc(1, sizeof(MCPoolTask_t)), * next = NULL;
+	size_t n_tasks = 1;
+	bool success = tasks != NULL;
+	while (success && n_tasks > 0 && tasks[0].args[0] < MCCLUSKEYCOVER_SPLIT_DEPTH &&
+		n_tasks < (n_threads * MCCLUSKEYCOVER_TASKS_PER_THREAD))
+	{
+		next = malloc(sizeof(MCPoolTask_t) * n_tasks * n_branches);
+		success = next != NULL;
+
+		size_t n_next = 0;
+		for (size_t i = 0; success && i < n_tasks; ++i)
+		{
+			size_t n_children;
+			success = McCluskeyCover_expand(This, &tasks[i], &next[n_next], &n_children);
+			n_next += n_children;
+		}
+
+		free(tasks);
+		tasks   = next;
+		next    = NULL;
+		n_tasks = n_next;
+	}
+
+	const size_t n_workers = (n_tasks < n_threads) ? n_tasks : n_threads;
+	McCluskeyCoverJob_t job = {
+		.workers    = calloc(n_workers + 1, sizeof(McCluskeyCover_t)),
+		.children   = malloc(sizeof(MCPoolTask_t) * n_branches * (n_workers + 1)),
+		.n_branches = n_branches,
+		.n_selected = This->n_selected,
+		.n_bans     = This->n_bans
+	};
+	success = success && job.workers != NULL && job.children != NULL;
+
+	// Nodes spent while splitting count towards the budget of the workers
+	atomic_store(&sharedSpent, This->n_spent);
+	atomic_store(&sharedExpired, This->expired);
+	This->sharedSpent   = &sharedSpent;
+	This->sharedExpired = &sharedExpired;
+
+	size_t n_clones = 0;
+	for (; success && n_clones < n_workers; ++n_clones)
+	{
+		success = McCluskeyCover_clone(&job.workers[n_clones], This);
+	}
+	if (success && n_tasks > 0)
+	{
+		success = MCPool_run(n_workers, tasks, n_tasks, &McCluskeyCover_task, &job);
+	}
+
+	// Keep only covers of the globally best size
+	const size_t best = atomic_load(&sharedBest);
+	if (best < This->best)
+	{
+		// Covers found while splitting are larger
+		This->best        = best;
+		This->n_solutions = 0;
+	}
+	This->sharedBest    = NULL;
+	This->sharedSpent   = NULL;
+	This->sharedExpired = NULL;
+	This->expired       = atomic_load(&sharedExpired);
+	for (size_t i = 0; i < n_clones; ++i)
+	{
+		MCCLUSKEY_STAT(This->n_visited  += job.workers[i].n_visited);
+		MCCLUSKEY_STAT(This->n_recorded += job.workers[i].n_recorded);
+		success = success && McCluskeyCover_merge(This, &job.workers[i]);
+		McCluskeyCover_destroyClone(&job.workers[i]);
+	}
+
+	free(job.workers);
+	free(job.children);
+	free(tasks);
+	return success;
+}
+void McCluskeyCover_setBudget(McCluskeyCover_t * restrict This, double seconds, uint64_t nodes)
+{
+	This->nodeBudget = nodes;
+	This->deadline   = (seconds > 0.0) ? McCluskeyCover_now() + seconds : 0.0;
+}
+bool McCluskeyCover_warmStart(McCluskeyCover_t * restrict This, const uint32_t * restrict primes, size_t n_primes)
+{
+	uint64_t * uncovered = malloc(sizeof(uint64_t) * (This->n_words + 1));
+	uint32_t * chosen    = malloc(sizeof(uint32_t) * (This->n_primes + 1));
+	if (uncovered == NULL || chosen == NULL)
+	{
+		free(uncovered);
+		free(chosen);
+		return false;
+	}
+	memcpy(uncovered, This->uncovered, sizeof(uint64_t) * This->n_words);
+
+	size_t size = 0, n_left = This->n_minterms;
+	for (size_t i = 0; n_left > 0; ++i)
+	{
+		// Given primes first, then the prime covering the most uncovered minterms
+		size_t prime = SIZE_MAX, gain = 0;
+		if (i < n_primes)
+		{
+			prime = primes[i];
+			if (prime >= This->n_primes)
+			{
+				continue;
+			}
+			const uint64_t * row = &This->rows[This->n_words * prime];
+			for (size_t w = 0; w < This->n_words; ++w)
+			{
+				gain += (size_t)__builtin_popcountll(row[w] & uncovered[w]);
+			}
+		}
+		else
+		{
+			for (size_t p = 0; p < This->n_primes; ++p)
+			{
+				const uint64_t * row = &This->rows[This->n_words * p];
+				size_t n = 0;
+				for (size_t w = 0; w < This->n_words; ++w)
+				{
+					n += (size_t)__builtin_popcountll(row[w] & uncovered[w]);
+				}
+				if (n > gain)
+				{
+					prime = p;
+					gain  = n;
+				}
+			}
+		}
+		if (gain == 0 && i < n_primes)
+		{
+			continue;
+		}
+		else if (gain == 0)
+		{
+			// Every minterm has a prime, not reached
+			break;
+		}
+
+		const uint64_t * row = &This->rows[This->n_words * prime];
+		for (size_t w = 0; w < This->n_words; ++w)
+		{
+			uncovered[w] &= ~row[w];
+		}
+		n_left -= gain;
+
+		// Keep the cover ordered
+		size_t j = size;
+		for (; j > 0 && chosen[j - 1] > prime; --j)
+		{
+			chosen[j] = chosen[j - 1];
+		}
+		chosen[j] = (uint32_t)prime;
+		++size;
+	}
+	free(uncovered);
+
+	if (n_left == 0 && size < This->upperBound)
+	{
+		This->upperBound = size;
+		free(This->incumbent);
+		This->incumbent   = chosen;
+		This->n_incumbent = size;
+	}
+	else
+	{
+		free(chosen);
+	}
+	return true;
+}
+bool McCluskeyCover_solve(McCluskeyCover_t * restrict This, size_t n_threads)
+{
+	This->best        = This->upperBound;
+	This->n_solutions = 0;
+	if (McCluskeyCover_reduce(This) == false)
+	{
+		return false;
+	}
+
+	if (n_threads == 0)
+	{
+		n_threads = MCPool_hardwareThreads();
+	}
+	if (((n_threads > 1) ? McCluskeyCover_searchParallel(This, n_threads) : McCluskeyCover_search(This)) == false ||
+		McCluskeyCover_sort(This) == false)
+	{
+		return false;
+	}
+
+	// Out of budget before finding a cover as small as the bound
+	if (This->n_solutions == 0 && This->n_incumbent > 0)
+	{
+		uint32_t * mem = realloc(This->solutions, sizeof(uint32_t) * (This->n_incumbent + 1));
+		if (mem == NULL)
+		{
+			return false;
+		}
+		memcpy(mem, This->incumbent, sizeof(uint32_t) * This->n_incumbent);
+		This->solutions     = mem;
+		This->cap_solutions = 1;
+		This->n_solutions   = 1;
+		This->best          = This->n_incumbent;
+	}
+	return true;
+}
+bool McCluskeyCover_isOptimal(const McCluskeyCover_t * restrict This)
+{
+	return !This->expired;
+}
+size_t McCluskeyCover_getCount(const McCluskeyCover_t * restrict This)
+{
+	return This->n_solutions;
+}
+size_t McCluskeyCover_getSize(const McCluskeyCover_t * restrict This)
+{
+	return (This->n_solutions > 0) ? This->best : 0;
+}
+size_t McCluskeyCover_getEssentialCount(const McCluskeyCover_t * restrict This)
+{
+	return This->n_essential;
+}
+const uint32_t * McCluskeyCover_getSolution(const McCluskeyCover_t * restrict This, size_t idx)
+{
+	return &This->solutions[This->best * idx];
+}
+void McCluskeyCover_destroy(McCluskeyCover_t * restrict This)
+{
+	free(This->primeOff);
+	free(This->primeMinterms);
+	free(This->mintermOff);
+	free(This->mintermPrimes);
+	free(This->rows);
+	free(This->uncovered);
+	free(This->n_uncovered);
+	free(This->avail);
+	free(This->banned);
+	free(This->bans);
+	free(This->stamps);
+	free(This->selected);
+	free(This->solutions);
+	free(This->incumbent);
+	memset(This, 0, sizeof(McCluskeyCover_t));
+}
@@ -0,0 +1,165 @@
+#ifndef MC_COVER_H
+#define MC_COVER_H
+
+#include "mccluskey.h"
+
+#include <stdatomic.h>
+
+///
+///	@brief Number of search tree nodes of a worker between checks of the time budget
+///	and between additions to the node count shared by a parallel search
+///
+#define MCCLUSKEYCOVER_BUDGET_INTERVAL 256
+
+///
+///	@brief Minimum exact cover problem of prime implicants over the minterms they
+///	cover, solved by branch and bound. A minterm is a '1' of 1 output, so a prime
+///	shared by several outputs is counted once
+///
+typedef struct McCluskeyCover
+{
+	size_t n_primes, n_minterms;
+
+	// Minterms covered by each prime
+	size_t * primeOff;
+	uint32_t * primeMinterms;
+	// Primes covering each minterm
+	size_t * mintermOff;
+	uint32_t * mintermPrimes;
+
+	// Incidence matrix, 1 bitset row of minterms per prime
+	uint64_t * rows;
+	size_t n_words;
+	// Uncovered minterms and their count for every depth of the selection
+	uint64_t * uncovered;
+	size_t * n_uncovered;
+	size_t cap_depth;
+
+	// Number of primes not excluded from the search covering each minterm
+	uint32_t * avail;
+	bool * banned;
+	uint32_t * bans;
+	size_t n_bans;
+	// Number of essential primes
+	size_t n_essential;
+	// Scratch marks for lower bound
+	uint32_t * stamps;
+	uint32_t stamp;
+
+	uint32_t * selected;
+	size_t n_selected;
+
+	// Size of the best cover found
+	size_t best;
+	// Size of a known cover, larger covers aren't searched
+	size_t upperBound;
+	// Best cover size shared between workers of a parallel search, NULL if none
+	atomic_size_t * sharedBest;
+	// Minimum covers, best elements each, ordered lexicographically once the search
+	// is done
+	uint32_t * solutions;
+	size_t n_solutions, cap_solutions;
+
+	// Search tree nodes visited and covers recorded, for McCluskeyStats_t
+	uint64_t n_visited, n_recorded;
+
+	// Search budget: search tree nodes, 0 if unlimited, and deadline in seconds of
+	// timespec_get, 0 if none
+	uint64_t nodeBudget;
+	double deadline;
+	// Search tree nodes spent of the budget by this worker
+	uint64_t n_spent;
+	// Nodes spent and whether the budget ran out, shared between workers of a
+	// parallel search, NULL if none
+	atomic_uint_fast64_t * sharedSpent;
+	atomic_bool * sharedExpired;
+	// Whether the budget ran out, the covers found are then not proven minimum
+	bool expired;
+	// Ascending primes of the smallest cover given by McCluskeyCover_warmStart,
+	// returned if the search finds no cover within its budget
+	uint32_t * incumbent;
+	size_t n_incumbent;
+
+} McCluskeyCover_t;
+
+///
+///	@brief Creates the cover problem of given prime implicants
+///	@param This Pointer to cover object
+///	@param primes Layer of prime implicants, the parents of which are the minterms
+///	to be covered
+///	@param base Layer of input nodes the parent indices refer to, the '1' outputs
+///	of which are covered
+///	@returns Whether the operation was successful
+///
+bool McCluskeyCover_make(
+	McCluskeyCover_t * restrict This,
+	const McCluskeyVals_t * restrict primes,
+	const McCluskeyVals_t * restrict base
+);
+///
+///	@brief Limits the search of McCluskeyCover_solve, which then returns the best
+///	covers found when the budget runs out. Nodes are counted like n_visited, a
+///	single search stops at the node budget, a parallel search may exceed it by up to
+///	MCCLUSKEYCOVER_BUDGET_INTERVAL nodes per worker
+///	@param This Pointer to cover object
+///	@param seconds Wall-clock time from now on, 0 if unlimited
+///	@param nodes Number of search tree nodes, 0 if unlimited
+///
+void McCluskeyCover_setBudget(McCluskeyCover_t * restrict This, double seconds, uint64_t nodes);
+///
+///	@brief Completes a selection of primes greedily to a cover, the primes covering
+///	the most uncovered minterms first, and bounds the search by its size. The
+///	smallest such cover is kept as a fallback for a search out of budget
+///	@param This Pointer to cover object
+///	@param primes Array of prime indices to start with, such as the primes of a
+///	previous cover still present
+///	@param n_primes Number of primes
+///	@returns Whether the operation was successful
+///
+bool McCluskeyCover_warmStart(McCluskeyCover_t * restrict This, const uint32_t * restrict primes, size_t n_primes);
+///
+///	@brief Finds all minimum covers. Essential primes, the only primes covering
+///	some minterm, are fixed first and only the remaining cyclic core is searched.
+///	With multiple threads the subtrees of the first decisions are searched by a
+///	work-stealing pool, all workers prune with the best cover size of any worker.
+///	If the budget runs out, the covers of the best size found so far are kept, or
+///	the cover of McCluskeyCover_warmStart if none was found
+///	@param This Pointer to cover object
+///	@param n_threads Number of threads, 0 uses all hardware threads
+///	@returns Whether the operation was successful
+///
+bool McCluskeyCover_solve(McCluskeyCover_t * restrict This, size_t n_threads);
+///
+///	@param This Pointer to cover object
+///	@returns Whether the covers found are proven to be all minimum covers, false if
+///	the budget ran out
+///
+bool McCluskeyCover_isOptimal(const McCluskeyCover_t * restrict This);
+///
+///	@param This Pointer to cover object
+///	@returns Number of minimum covers found
+///
+size_t McCluskeyCover_getCount(const McCluskeyCover_t * restrict This);
+///
+///	@param This Pointer to cover object
+///	@returns Number of primes in each minimum cover
+///
+size_t McCluskeyCover_getSize(const McCluskeyCover_t * restrict This);
+///
+///	@param This Pointer to cover object
+///	@returns Number of essential primes, which are part of every minimum cover
+///
+size_t McCluskeyCover_getEssentialCount(const McCluskeyCover_t * restrict This);
+///
+///	@param This Pointer to cover object
+///	@param idx Index of the cover
+///	@returns Ascending prime indices of the cover
+///
+const uint32_t * McCluskeyCover_getSolution(const McCluskeyCover_t * restrict This, size_t idx);
+///
+///	@brief Destroys cover object
+///	@param This Pointer to cover object
+///
+void McCluskeyCover_destroy(McCluskeyCover_t * restrict This);
+
+#endif
@@ -0,0 +1,492 @@
+#include "mcespresso.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+///
+///	@brief Appends a cube to a cube array, growing the array if needed
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyCube_push(McCluskeyCube_t * restrict * restrict arr, size_t * restrict n, size_t * restrict cap, McCluskeyCube_t cube)
+{
+	if (*n >= *cap)
+	{
+		const size_t newcap = (*n + 1) * 2;
+		McCluskeyCube_t * mem = realloc(*arr, sizeof(McCluskeyCube_t) * newcap);
+		if (mem == NULL)
+		{
+			return false;
+		}
+		*arr = mem;
+		*cap = newcap;
+	}
+	(*arr)[*n] = cube;
+	++*n;
+	return true;
+}
+///
+///	@returns Whether 2 cubes have a common minterm
+///
+static inline bool McCluskeyCube_intersects(McCluskeyCube_t a, McCluskeyCube_t b)
+{
+	return ((a.ones ^ b.ones) & ~a.dashes & ~b.dashes) == 0;
+}
+///
+///	@returns Whether cube a contains cube b
+///
+static inline bool McCluskeyCube_contains(McCluskeyCube_t a, McCluskeyCube_t b)
+{
+	return (~a.dashes & b.dashes) == 0 && ((a.ones ^ b.ones) & ~a.dashes) == 0;
+}
+///
+///	@brief Sorting callback, cubes with more variables absent first
+///
+static int McCluskeyCube_cmpLargest(const void * a, const void * b)
+{
+	const int na = McCluskeyMask_popcount(((const McCluskeyCube_t *)a)->dashes);
+	const int nb = McCluskeyMask_popcount(((const McCluskeyCube_t *)b)->dashes);
+	return nb - na;
+}
+///
+///	@brief A cube of the on-set or don't care set with its position there
+///
+typedef struct McCluskeyCubeEntry
+{
+	McCluskeyCube_t cube;
+	size_t idx;
+	bool dc;
+
+} McCluskeyCubeEntry_t;
+///
+///	@brief Sorting callback, orders entries by their cube, on-set before don't care
+///	set and by position
+///
+static int McCluskeyCubeEntry_cmp(const void * a, const void * b)
+{
+	const McCluskeyCubeEntry_t * ea = a, * eb = b;
+	if (ea->cube.dashes != eb->cube.dashes)
+	{
+		return ea->cube.dashes < eb->cube.dashes ? -1 : 1;
+	}
+	if (ea->cube.ones != eb->cube.ones)
+	{
+		return ea->cube.ones < eb->cube.ones ? -1 : 1;
+	}
+	if (ea->dc != eb->dc)
+	{
+		return ea->dc ? 1 : -1;
+	}
+	return (ea->idx > eb->idx) - (ea->idx < eb->idx);
+}
+
+///
+///	@brief Checks whether the cubes of stack in [begin, end) cover every minterm
+///	over the free variables
+///	@returns Whether the cubes form a tautology
+///
+static bool McCluskeyEspresso_tautology(McCluskeyEspresso_t * restrict This, size_t begin, size_t end, McCluskeyMask_t freeMask)
+{
+	if (begin == end || This->failed)
+	{
+		return false;
+	}
+
+	// A universal cube is a tautology, too few minterms can't be
+	const uint8_t n_free = McCluskeyMask_popcount(freeMask);
+	uint64_t n_minterms = 0;
+	for (size_t i = begin; i < end; ++i)
+	{
+		const uint8_t n_dashes = McCluskeyMask_popcount(This->stack[i].dashes & freeMask);
+		if (n_dashes == n_free)
+		{
+			return true;
+		}
+		const uint64_t n_cube = (n_dashes < 63) ? ((uint64_t)1 << n_dashes) : UINT64_MAX;
+		n_minterms = ((UINT64_MAX - n_minterms) > n_cube) ? (n_minterms + n_cube) : UINT64_MAX;
+	}
+	if (n_free < 63 && n_minterms < ((uint64_t)1 << n_free))
+	{
+		return false;
+	}
+
+	// Split on the most binate variable, unate covers without a universal cube
+	// are never tautologies
+	McCluskeyMask_t splitBit = 0;
+	size_t splitCount = 0;
+	for (McCluskeyMask_t vars = freeMask; vars != 0; vars &= vars - 1)
+	{
+		const McCluskeyMask_t bit = vars & (~vars + 1);
+		size_t n_ones = 0, n_zeros = 0;
+		for (size_t i = begin; i < end; ++i)
+		{
+			if ((This->stack[i].dashes & bit) == 0)
+			{
+				n_ones  += (This->stack[i].ones & bit) != 0;
+				n_zeros += (This->stack[i].ones & bit) == 0;
+			}
+		}
+		if (n_ones > 0 && n_zeros > 0 && (n_ones + n_zeros) > splitCount)
+		{
+			splitBit   = bit;
+			splitCount = n_ones + n_zeros;
+		}
+	}
+	if (splitBit == 0)
+	{
+		return false;
+	}
+
+	for (int value = 0; value < 2; ++value)
+	{
+		const McCluskeyMask_t ones = value ? splitBit : 0;
+		const size_t cofactor = This->n_stack;
+		for (size_t i = begin; i < end; ++i)
+		{
+			McCluskeyCube_t cube = This->stack[i];
+			if ((cube.dashes & splitBit) == 0 && (cube.ones & splitBit) != ones)
+			{
+				continue;
+			}
+			cube.dashes |= splitBit;
+			cube.ones   &= ~splitBit;
+			if (McCluskeyCube_push(&This->stack, &This->n_stack, &This->cap_stack, cube) == false)
+			{
+				This->failed = true;
+				return false;
+			}
+		}
+		const bool taut = McCluskeyEspresso_tautology(This, cofactor, This->n_stack, freeMask & ~splitBit);
+		This->n_stack = cofactor;
+		if (!taut)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+///
+///	@brief Checks whether the cube is covered by the on-set cover without cube skip
+///	and the don't care set
+///	@param skip Index of on-set cube left out, SIZE_MAX to use all cubes
+///	@returns Whether the cube is covered
+///
+static bool McCluskeyEspresso_covers(McCluskeyEspresso_t * restrict This, McCluskeyCube_t cube, size_t skip)
+{
+	// Cofactor of the cover with respect to the cube
+	This->n_stack = 0;
+	const McCluskeyMask_t literals = ~cube.dashes & This->varMask;
+	for (size_t i = 0; i < (This->n_on + This->n_dc); ++i)
+	{
+		McCluskeyCube_t other = (i < This->n_on) ? This->on[i] : This->dc[i - This->n_on];
+		if (i == skip || !McCluskeyCube_intersects(other, cube))
+		{
+			continue;
+		}
+		other.dashes |= literals;
+		other.ones   &= ~literals;
+		if (McCluskeyCube_push(&This->stack, &This->n_stack, &This->cap_stack, other) == false)
+		{
+			This->failed = true;
+			return false;
+		}
+	}
+	return McCluskeyEspresso_tautology(This, 0, This->n_stack, cube.dashes & This->varMask);
+}
+///
+///	@brief Removes on-set cube at index idx, order of the other cubes is kept
+///
+static inline void McCluskeyEspresso_remove(McCluskeyEspresso_t * restrict This, size_t idx)
+{
+	memmove(&This->on[idx], &This->on[idx + 1], sizeof(McCluskeyCube_t) * (This->n_on - idx - 1));
+	--This->n_on;
+}
+///
+///	@brief Removes repeated cubes from the on-set and don't care set and the don't
+///	care cubes also found in the on-set, first occurrences are kept in their order
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyEspresso_unique(McCluskeyEspresso_t * restrict This)
+{
+	const size_t n = This->n_on + This->n_dc;
+	McCluskeyCubeEntry_t * entries = malloc(sizeof(McCluskeyCubeEntry_t) * (n + 1));
+	bool * keep = calloc(n + 1, sizeof(bool));
+	if (entries == NULL || keep == NULL)
+	{
+		free(entries);
+		free(keep);
+		return false;
+	}
+	for (size_t i = 0; i < This->n_on; ++i)
+	{
+		entries[i] = (McCluskeyCubeEntry_t){ .cube = This->on[i], .idx = i, .dc = false };
+	}
+	for (size_t i = 0; i < This->n_dc; ++i)
+	{
+		entries[This->n_on + i] = (McCluskeyCubeEntry_t){ .cube = This->dc[i], .idx = i, .dc = true };
+	}
+	qsort(entries, n, sizeof(McCluskeyCubeEntry_t), &McCluskeyCubeEntry_cmp);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (i == 0 ||
+			entries[i].cube.dashes != entries[i - 1].cube.dashes ||
+			entries[i].cube.ones != entries[i - 1].cube.ones)
+		{
+			keep[entries[i].dc ? This->n_on + entries[i].idx : entries[i].idx] = true;
+		}
+	}
+
+	size_t n_on = 0, n_dc = 0;
+	for (size_t i = 0; i < This->n_on; ++i)
+	{
+		if (keep[i])
+		{
+			This->on[n_on] = This->on[i];
+			++n_on;
+		}
+	}
+	for (size_t i = 0; i < This->n_dc; ++i)
+	{
+		if (keep[This->n_on + i])
+		{
+			This->dc[n_dc] = This->dc[i];
+			++n_dc;
+		}
+	}
+	This->n_on = n_on;
+	This->n_dc = n_dc;
+
+	free(entries);
+	free(keep);
+	return true;
+}
+///
+///	@brief EXPAND, raises literals of every cube as long as the cube stays inside
+///	the on-set and don't care set, removes the cubes it swallows
+///
+static void McCluskeyEspresso_expand(McCluskeyEspresso_t * restrict This)
+{
+	qsort(This->on, This->n_on, sizeof(McCluskeyCube_t), &McCluskeyCube_cmpLargest);
+	for (size_t i = 0; i < This->n_on && !This->failed; ++i)
+	{
+		McCluskeyCube_t cube = This->on[i];
+
+		// Raise first the literals that keep most other cubes out of this cube
+		uint32_t weights[MCCLUSKEYVAL_MAX_ARGVEC] = { 0 };
+		for (size_t j = 0; j < This->n_on; ++j)
+		{
+			const McCluskeyMask_t apart = (This->on[j].dashes | (This->on[j].ones ^ cube.ones)) & ~cube.dashes;
+			for (McCluskeyMask_t vars = apart & This->varMask; vars != 0; vars &= vars - 1)
+			{
+				++weights[McCluskeyMask_ctz(vars)];
+			}
+		}
+		for (McCluskeyMask_t vars = ~cube.dashes & This->varMask; vars != 0; )
+		{
+			uint8_t var = McCluskeyMask_ctz(vars);
+			for (McCluskeyMask_t rest = vars & (vars - 1); rest != 0; rest &= rest - 1)
+			{
+				const uint8_t other = McCluskeyMask_ctz(rest);
+				var = (weights[other] > weights[var]) ? other : var;
+			}
+			const McCluskeyMask_t bit = (McCluskeyMask_t)1 << var;
+			vars &= ~bit;
+
+			const McCluskeyCube_t raised = { .ones = cube.ones & ~bit, .dashes = cube.dashes | bit };
+			if (McCluskeyEspresso_covers(This, raised, SIZE_MAX))
+			{
+				cube = raised;
+			}
+		}
+		This->on[i] = cube;
+
+		for (size_t j = This->n_on; j > 0; --j)
+		{
+			if ((j - 1) != i && McCluskeyCube_contains(cube, This->on[j - 1]))
+			{
+				McCluskeyEspresso_remove(This, j - 1);
+				i -= (j - 1) < i;
+			}
+		}
+	}
+}
+///
+///	@brief IRREDUNDANT, removes cubes covered by the rest of the cover, smallest
+///	cubes first
+///
+static void McCluskeyEspresso_irredundant(McCluskeyEspresso_t * restrict This)
+{
+	qsort(This->on, This->n_on, sizeof(McCluskeyCube_t), &McCluskeyCube_cmpLargest);
+	for (size_t i = This->n_on; i > 0 && !This->failed; --i)
+	{
+		if (McCluskeyEspresso_covers(This, This->on[i - 1], i - 1))
+		{
+			McCluskeyEspresso_remove(This, i - 1);
+		}
+	}
+}
+///
+///	@brief REDUCE, lowers absent variables of every cube to the half that isn't
+///	covered by the rest of the cover, so that EXPAND can grow it differently
+///
+static void McCluskeyEspresso_reduce(McCluskeyEspresso_t * restrict This)
+{
+	qsort(This->on, This->n_on, sizeof(McCluskeyCube_t), &McCluskeyCube_cmpLargest);
+	for (size_t i = 0; i < This->n_on && !This->failed; ++i)
+	{
+		McCluskeyCube_t cube = This->on[i];
+		for (McCluskeyMask_t vars = cube.dashes & This->varMask; vars != 0; vars &= vars - 1)
+		{
+			const McCluskeyMask_t bit = vars & (~vars + 1);
+			const McCluskeyCube_t zero = { .ones = cube.ones,       .dashes = cube.dashes & ~bit };
+			const McCluskeyCube_t one  = { .ones = cube.ones | bit, .dashes = cube.dashes & ~bit };
+			if (McCluskeyEspresso_covers(This, one, i))
+			{
+				cube = zero;
+			}
+			else if (McCluskeyEspresso_covers(This, zero, i))
+			{
+				cube = one;
+			}
+		}
+		This->on[i] = cube;
+	}
+}
+///
+///	@returns Cost of the cover, number of cubes first and number of literals second
+///
+static inline uint64_t McCluskeyEspresso_cost(const McCluskeyEspresso_t * restrict This)
+{
+	uint64_t literals = 0;
+	for (size_t i = 0; i < This->n_on; ++i)
+	{
+		literals += (uint64_t)McCluskeyMask_popcount(~This->on[i].dashes & This->varMask);
+	}
+	return ((uint64_t)This->n_on << 32) | literals;
+}
+
+///
+///	@brief Minimises 1 output of the function, adds the cubes of the cover to result
+///	with the output's tag
+///	@returns Whether the operation was successful
+///
+static bool McCluskeyEspresso_minimiseOutput(
+	McCluskeyEspresso_t * restrict This,
+	const McCluskeyVals_t * restrict base,
+	McCluskeyTag_t outBit,
+	uint8_t len,
+	McCluskeyVals_t * restrict result
+)
+{
+	This->n_on = 0;
+	This->n_dc = 0;
+	This->n_stack = 0;
+
+	bool success = true;
+	for (size_t i = 0; success && i < base->n_vals; ++i)
+	{
+		const McCluskeyCube_t cube = { .ones = base->ones[i], .dashes = base->dashes[i] };
+		if (base->onTags[i] & outBit)
+		{
+			success = McCluskeyCube_push(&This->on, &This->n_on, &This->cap_on, cube);
+		}
+		else if (base->dcTags[i] & outBit)
+		{
+			success = McCluskeyCube_push(&This->dc, &This->n_dc, &This->cap_dc, cube);
+		}
+	}
+
+	McCluskeyCube_t * best = NULL;
+	size_t n_best = 0;
+	if (success)
+	{
+		// Repeated rows would only slow down every step and change the cover found
+		success = McCluskeyEspresso_unique(This);
+	}
+	if (success)
+	{
+		McCluskeyEspresso_expand(This);
+		McCluskeyEspresso_irredundant(This);
+
+		uint64_t cost = McCluskeyEspresso_cost(This);
+		best = malloc(sizeof(McCluskeyCube_t) * (This->n_on + 1));
+		success = best != NULL;
+		while (success && !This->failed)
+		{
+			memcpy(best, This->on, sizeof(McCluskeyCube_t) * This->n_on);
+			n_best = This->n_on;
+
+			McCluskeyEspresso_reduce(This);
+			McCluskeyEspresso_expand(This);
+			McCluskeyEspresso_irredundant(This);
+
+			const uint64_t newCost = McCluskeyEspresso_cost(This);
+			if (newCost >= cost)
+			{
+				break;
+			}
+			cost = newCost;
+		}
+		success = success && !This->failed;
+	}
+
+	// Cubes found for several outputs are shared
+	for (size_t i = 0; success && i < n_best; ++i)
+	{
+		const McCluskeyVal_t val = {
+			.ones      = best[i].ones,
+			.dashes    = best[i].dashes,
+			.onTag     = outBit,
+			.len       = len,
+			.numOnes   = McCluskeyMask_popcount(best[i].ones),
+			.n_outputs = base->n_outputs,
+			.state     = McCluskeyState_one
+		};
+		bool inserted;
+		success = McCluskeyVals_pushUnique(result, &val, &inserted);
+	}
+
+	free(best);
+	return success;
+}
+
+bool McCluskeyEspresso_minimise(const McCluskeyVals_t * restrict base, McCluskeyVals_t * restrict result)
+{
+	McCluskeyEspresso_t esp;
+	memset(&esp, 0, sizeof(McCluskeyEspresso_t));
+
+	uint8_t len = 0;
+	for (size_t i = 0; i < base->n_vals; ++i)
+	{
+		len = (base->lens[i] > len) ? base->lens[i] : len;
+	}
+	esp.varMask = (len >= MCCLUSKEYVAL_MAX_ARGVEC) ? (McCluskeyMask_t)~(McCluskeyMask_t)0 :
+		(McCluskeyMask_t)(((McCluskeyMask_t)1 << len) - 1);
+
+	// Every output is minimised on its own, equal cubes of different outputs merge
+	const uint8_t n_outputs = (base->n_outputs == 0) ? 1 : base->n_outputs;
+	bool success = true;
+	for (uint8_t out = 0; success && out < n_outputs; ++out)
+	{
+		success = McCluskeyEspresso_minimiseOutput(&esp, base, (McCluskeyTag_t)1 << out, len, result);
+	}
+
+	// On-set nodes intersecting a cube at any of its outputs are its parents
+	for (size_t i = 0; success && i < result->n_vals; ++i)
+	{
+		const McCluskeyCube_t cube = { .ones = result->ones[i], .dashes = result->dashes[i] };
+		for (uint32_t j = 0; success && j < base->n_vals; ++j)
+		{
+			const McCluskeyCube_t node = { .ones = base->ones[j], .dashes = base->dashes[j] };
+			if ((base->onTags[j] & result->onTags[i]) != 0 && McCluskeyCube_intersects(cube, node))
+			{
+				success = McCluskeyVals_addParents(result, i, &j, 1);
+			}
+		}
+	}
+
+	free(esp.on);
+	free(esp.dc);
+	free(esp.stack);
+	return success;
+}
@@ -0,0 +1,49 @@
+#ifndef MC_ESPRESSO_H
+#define MC_ESPRESSO_H
+
+#include "mccluskey.h"
+
+///
+///	@brief A product term, variables set in dashes are absent from the term
+///
+typedef struct McCluskeyCube
+{
+	McCluskeyMask_t ones, dashes;
+
+} McCluskeyCube_t;
+
+///
+///	@brief Heuristic minimiser working directly on cubes, repeats the EXPAND,
+///	IRREDUNDANT and REDUCE steps of Espresso as long as the cover improves
+///
+typedef struct McCluskeyEspresso
+{
+	McCluskeyMask_t varMask;
+
+	// Current cover of the on-set
+	McCluskeyCube_t * on;
+	size_t n_on, cap_on;
+	// Don't care set
+	McCluskeyCube_t * dc;
+	size_t n_dc, cap_dc;
+
+	// Stack of cofactors for tautology checks
+	McCluskeyCube_t * stack;
+	size_t n_stack, cap_stack;
+	bool failed;
+
+} McCluskeyEspresso_t;
+
+///
+///	@brief Minimises the function given by a layer of input nodes, for every output
+///	the nodes tagged '1' form the on-set and the nodes tagged '-' the don't care set,
+///	everything else is off-set. Outputs are minimised one by one, cubes found for
+///	several outputs are shared
+///	@param base Layer of input nodes
+///	@param result Empty layer receiving the cubes of the cover, parents of each cube
+///	are the on-set nodes of base intersecting it at any of its outputs
+///	@returns Whether the operation was successful
+///
+bool McCluskeyEspresso_minimise(const McCluskeyVals_t * restrict base, McCluskeyVals_t * restrict result);
+
+#endif
@@ -0,0 +1,902 @@
+#include "mcinput.h"
+#include "mcpool.h"
+#include "mcsimd.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+///
+///	@brief Part of a line between whitespace
+///
+typedef struct McCluskeyToken
+{
+	const char * str;
+	size_t len;
+
+} McCluskeyToken_t;
+
+///
+///	@returns Whether the character separates tokens
+///
+static inline bool McCluskeyInput_isSpace(char ch)
+{
+	return (ch == ' ') | (ch == '\t') | (ch == '\r');
+}
+///
+///	@brief Finds the next token of a line starting from *pos
+///	@returns Whether a token was found
+///
+static inline bool McCluskeyInput_nextToken(const char * restrict line, size_t len, size_t * restrict pos, McCluskeyToken_t * restrict tok)
+{
+	size_t i = *pos;
+	while (i < len && McCluskeyInput_isSpace(line[i]))
+	{
+		++i;
+	}
+	if (i >= len)
+	{
+		*pos = i;
+		return false;
+	}
+	tok->str = &line[i];
+	while (i < len && !McCluskeyInput_isSpace(line[i]))
+	{
+		++i;
+	}
+	tok->len = (size_t)(&line[i] - tok->str);
+	*pos = i;
+	return true;
+}
+///
+///	@brief Parses a decimal number from str[*pos], advances *pos past it
+///	@returns Whether a number without overflow was found
+///
+static inline bool McCluskeyInput_parseNum(const char * restrict str, size_t len, size_t * restrict pos, uint64_t * restrict num)
+{
+	size_t i = *pos;
+	uint64_t value = 0;
+	for (; i < len && str[i] >= '0' && str[i] <= '9'; ++i)
+	{
+		const uint64_t digit = (uint64_t)(str[i] - '0');
+		if (value > ((UINT64_MAX - digit) / 10))
+		{
+			return false;
+		}
+		value = value * 10 + digit;
+	}
+	if (i == *pos)
+	{
+		return false;
+	}
+	*pos = i;
+	*num = value;
+	return true;
+}
+///
+///	@returns Whether the token is exactly equal to the string
+///
+static inline bool McCluskeyInput_tokenIs(const McCluskeyToken_t * restrict tok, const char * restrict str)
+{
+	return tok->len == strlen(str) && memcmp(tok->str, str, tok->len) == 0;
+}
+///
+///	@returns Base 2 logarithm of n, 0 if n isn't a power of 2 larger than 1
+///
+static inline uint8_t McCluskeyInput_log2(size_t n)
+{
+	if (n < 2 || (n & (n - 1)) != 0)
+	{
+		return 0;
+	}
+	return (uint8_t)__builtin_ctzll((unsigned long long)n);
+}
+///
+///	@brief Adds a node to the array, state follows from the output tags
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyInput_push(
+	McCluskeyVals_t * restrict vals,
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes,
+	uint8_t len,
+	McCluskeyTag_t onTag,
+	McCluskeyTag_t dcTag,
+	uint8_t n_outputs
+)
+{
+	const McCluskeyVal_t val = {
+		.ones      = ones,
+		.dashes    = dashes,
+		.onTag     = onTag,
+		.dcTag     = dcTag,
+		.len       = len,
+		.numOnes   = McCluskeyMask_popcount(ones),
+		.n_outputs = n_outputs,
+		.state     = (onTag != 0) ? McCluskeyState_one : McCluskeyState_undefined
+	};
+	return McCluskeyVals_push(vals, &val);
+}
+///
+///	@returns Whether the number of outputs agrees with the previous lines
+///
+static inline bool McCluskeyInput_checkOutputs(const McCluskeyInput_t * restrict This, size_t n_outputs)
+{
+	return (This->n_outputs == 0) || (This->n_outputs == n_outputs);
+}
+
+///
+///	@brief Parses a PLA directive
+///
+static inline bool McCluskeyInput_directive(McCluskeyInput_t * restrict This, const char * restrict line, size_t len, bool * restrict valid)
+{
+	size_t pos = 0;
+	McCluskeyToken_t name = { 0 }, arg = { 0 };
+	McCluskeyInput_nextToken(line, len, &pos, &name);
+	const bool hasArg = McCluskeyInput_nextToken(line, len, &pos, &arg);
+	This->pla = true;
+
+	if (McCluskeyInput_tokenIs(&name, ".i") || McCluskeyInput_tokenIs(&name, ".o"))
+	{
+		const bool inputs = (name.str[1] == 'i');
+		size_t argPos = 0;
+		uint64_t num;
+		if (hasArg == false || McCluskeyInput_parseNum(arg.str, arg.len, &argPos, &num) == false ||
+			argPos != arg.len || num == 0 ||
+			(inputs && num > MCCLUSKEYVAL_MAX_ARGVEC) ||
+			(inputs == false && (num > MCCLUSKEYVAL_MAX_OUTPUTS || McCluskeyInput_checkOutputs(This, (size_t)num) == false))
+		)
+		{
+			return true;
+		}
+		if (inputs)
+		{
+			This->n_inputs = (uint8_t)num;
+		}
+		else
+		{
+			This->n_outputs = (uint8_t)num;
+		}
+	}
+	// Names, number of cubes and the end of the table carry no information
+	else if (!McCluskeyInput_tokenIs(&name, ".p")     && !McCluskeyInput_tokenIs(&name, ".type") &&
+		!McCluskeyInput_tokenIs(&name, ".ilb")   && !McCluskeyInput_tokenIs(&name, ".ob") &&
+		!McCluskeyInput_tokenIs(&name, ".phase") && !McCluskeyInput_tokenIs(&name, ".e") &&
+		!McCluskeyInput_tokenIs(&name, ".end")
+	)
+	{
+		return true;
+	}
+
+	*valid = true;
+	return true;
+}
+///
+///	@brief Parses minterm/maxterm/don't care index lists, the first pass validates
+///	the line and finds the largest index, the second pass adds the nodes
+///
+static inline bool McCluskeyInput_lists(McCluskeyInput_t * restrict This, bool first, const char * restrict line, size_t len, McCluskeyVals_t * restrict vals, bool * restrict valid)
+{
+	if (McCluskeyInput_checkOutputs(This, 1) == false)
+	{
+		return true;
+	}
+	// Maxterms on the first line select zeros' mode
+	if (first && vals->n_vals == 0 && memchr(line, 'M', len) != NULL)
+	{
+		McCluskeyCtx_setMode(This->ctx, '0');
+	}
+
+	uint64_t maxIdx = 0;
+	uint8_t n_vars = This->n_inputs;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		size_t pos = 0;
+		while (1)
+		{
+			while (pos < len && McCluskeyInput_isSpace(line[pos]))
+			{
+				++pos;
+			}
+			if (pos >= len)
+			{
+				break;
+			}
+			else if ((pos + 1) >= len || line[pos + 1] != '(' ||
+				(line[pos] != 'm' && line[pos] != 'M' && line[pos] != 'd')
+			)
+			{
+				return true;
+			}
+
+			const char valueCh = (line[pos] == 'm') ? '1' : (line[pos] == 'M') ? '0' : '-';
+			const McCluskeyState_t state = McCluskey_getState(This->ctx, valueCh);
+			if (state == McCluskeyState_zero)
+			{
+				// Minterms in zeros' mode or maxterms in ones' mode
+				return true;
+			}
+			pos += 2;
+
+			while (1)
+			{
+				while (pos < len && McCluskeyInput_isSpace(line[pos]))
+				{
+					++pos;
+				}
+				if (pos < len && line[pos] == ')')
+				{
+					++pos;
+					break;
+				}
+				uint64_t idx;
+				if (McCluskeyInput_parseNum(line, len, &pos, &idx) == false)
+				{
+					return true;
+				}
+				while (pos < len && McCluskeyInput_isSpace(line[pos]))
+				{
+					++pos;
+				}
+				if (pos < len && line[pos] == ',')
+				{
+					++pos;
+				}
+				else if (pos >= len || line[pos] != ')')
+				{
+					return true;
+				}
+
+				if (pass == 0)
+				{
+					maxIdx = (idx > maxIdx) ? idx : maxIdx;
+				}
+				else if (McCluskeyInput_push(
+					vals, (McCluskeyMask_t)idx, 0, n_vars,
+					(state == McCluskeyState_one) ? 1 : 0, (state == McCluskeyState_undefined) ? 1 : 0, 1
+				) == false)
+				{
+					return false;
+				}
+			}
+		}
+
+		if (pass == 0)
+		{
+			if (n_vars == 0)
+			{
+				const uint8_t bits = (uint8_t)(64 - __builtin_clzll(maxIdx | 1));
+				n_vars = (bits > MCCLUSKEYVAL_MAX_ARGVEC) ? 0 : bits;
+			}
+			if (n_vars == 0 || (n_vars < 64 && (maxIdx >> n_vars) != 0))
+			{
+				return true;
+			}
+		}
+	}
+
+	This->n_outputs = 1;
+	*valid = true;
+	return true;
+}
+///
+///	@brief Parses truth table vectors in hex, 1 per output
+///
+static inline bool McCluskeyInput_hex(McCluskeyInput_t * restrict This, const char * restrict line, size_t len, McCluskeyVals_t * restrict vals, bool * restrict valid)
+{
+	McCluskeyToken_t toks[MCCLUSKEYVAL_MAX_OUTPUTS];
+	size_t n_toks = 0, pos = 0;
+	McCluskeyToken_t tok;
+	while (McCluskeyInput_nextToken(line, len, &pos, &tok))
+	{
+		if (n_toks >= MCCLUSKEYVAL_MAX_OUTPUTS || tok.len < 3 || tok.str[0] != '0' ||
+			(tok.str[1] != 'x' && tok.str[1] != 'X') || (n_toks > 0 && tok.len != toks[0].len)
+		)
+		{
+			return true;
+		}
+		for (size_t i = 2; i < tok.len; ++i)
+		{
+			const char ch = tok.str[i];
+			if (!((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F')))
+			{
+				return true;
+			}
+		}
+		toks[n_toks] = tok;
+		++n_toks;
+	}
+
+	const size_t n_digits = toks[0].len - 2;
+	const uint8_t n_vars = McCluskeyInput_log2(n_digits * 4);
+	if (n_vars == 0 || n_vars > MCCLUSKEYVAL_MAX_ARGVEC || (This->n_inputs != 0 && n_vars != This->n_inputs) ||
+		McCluskeyInput_checkOutputs(This, n_toks) == false
+	)
+	{
+		return true;
+	}
+
+	const McCluskeyState_t states[2] = { McCluskey_getState(This->ctx, '0'), McCluskey_getState(This->ctx, '1') };
+	// Last digit holds minterms 0 to 3
+	for (size_t d = 0; d < n_digits; ++d)
+	{
+		uint8_t nibbles[MCCLUSKEYVAL_MAX_OUTPUTS];
+		for (size_t t = 0; t < n_toks; ++t)
+		{
+			const char ch = toks[t].str[toks[t].len - 1 - d];
+			nibbles[t] = (uint8_t)((ch <= '9') ? (ch - '0') : ((ch | 0x20) - 'a' + 10));
+		}
+		for (uint8_t b = 0; b < 4; ++b)
+		{
+			McCluskeyTag_t onTag = 0;
+			for (size_t t = 0; t < n_toks; ++t)
+			{
+				onTag |= (McCluskeyTag_t)(states[(nibbles[t] >> b) & 1] == McCluskeyState_one) << t;
+			}
+			if (onTag != 0 &&
+				McCluskeyInput_push(vals, (McCluskeyMask_t)(d * 4 + b), 0, n_vars, onTag, 0, (uint8_t)n_toks) == false
+			)
+			{
+				return false;
+			}
+		}
+	}
+
+	This->n_outputs = (uint8_t)n_toks;
+	*valid = true;
+	return true;
+}
+///
+///	@brief Parses a truth table vector given as a bit string
+///
+static inline bool McCluskeyInput_bitString(McCluskeyInput_t * restrict This, const McCluskeyToken_t * restrict tok, McCluskeyVals_t * restrict vals, bool * restrict valid)
+{
+	const uint8_t n_vars = McCluskeyInput_log2(tok->len);
+	if (n_vars == 0 || n_vars > MCCLUSKEYVAL_MAX_ARGVEC || (This->n_inputs != 0 && n_vars != This->n_inputs) ||
+		McCluskeyInput_checkOutputs(This, 1) == false
+	)
+	{
+		return true;
+	}
+	for (size_t i = 0; i < tok->len; ++i)
+	{
+		if (McCluskey_getRawState(tok->str[i]) == McCluskeyState_terminator)
+		{
+			return true;
+		}
+	}
+
+	for (size_t i = 0; i < tok->len; ++i)
+	{
+		const McCluskeyState_t state = McCluskey_getState(This->ctx, tok->str[i]);
+		if (state != McCluskeyState_zero &&
+			McCluskeyInput_push(
+				vals, (McCluskeyMask_t)i, 0, n_vars,
+				(state == McCluskeyState_one) ? 1 : 0, (state == McCluskeyState_undefined) ? 1 : 0, 1
+			) == false
+		)
+		{
+			return false;
+		}
+	}
+
+	This->n_outputs = 1;
+	*valid = true;
+	return true;
+}
+///
+///	@brief Parses a line of an argument vector and its values
+///
+static inline bool McCluskeyInput_row(McCluskeyInput_t * restrict This, const McCluskeyToken_t * restrict argvec, const McCluskeyToken_t * restrict values, McCluskeyVals_t * restrict vals, bool * restrict valid)
+{
+	if (argvec->len > MCCLUSKEYVAL_MAX_ARGVEC || values->len > MCCLUSKEYVAL_MAX_OUTPUTS ||
+		(This->n_inputs != 0 && argvec->len != This->n_inputs) ||
+		McCluskeyInput_checkOutputs(This, values->len) == false
+	)
+	{
+		return true;
+	}
+
+	McCluskeyMask_t ones = 0, dashes = 0;
+	for (size_t i = 0; i < argvec->len; ++i)
+	{
+		// Store the value backwards
+		const McCluskeyMask_t bit = (McCluskeyMask_t)1 << (argvec->len - i - 1);
+		switch (McCluskey_getRawState(argvec->str[i]))
+		{
+		case McCluskeyState_zero:
+			break;
+		case McCluskeyState_one:
+			ones |= bit;
+			break;
+		case McCluskeyState_undefined:
+			dashes |= bit;
+			break;
+		default:
+			return true;
+		}
+	}
+
+	McCluskeyTag_t onTag = 0, dcTag = 0;
+	for (size_t i = 0; i < values->len; ++i)
+	{
+		const McCluskeyTag_t bit = (McCluskeyTag_t)1 << i;
+		// PLA marks outputs without meaning with '~'
+		const char ch = (This->pla && values->str[i] == '~') ? McCluskey_getChar(This->ctx, McCluskeyState_zero) : values->str[i];
+		switch (McCluskey_getState(This->ctx, ch))
+		{
+		case McCluskeyState_zero:
+			break;
+		case McCluskeyState_one:
+			onTag |= bit;
+			break;
+		case McCluskeyState_undefined:
+			dcTag |= bit;
+			break;
+		default:
+			return true;
+		}
+	}
+
+	if ((onTag | dcTag) == 0)
+	{
+		// Off-set cubes of PLA are left out
+		*valid = This->pla;
+		This->n_outputs = This->pla ? (uint8_t)values->len : This->n_outputs;
+		return true;
+	}
+
+	This->n_outputs = (uint8_t)values->len;
+	*valid = true;
+	return McCluskeyInput_push(vals, ones, dashes, (uint8_t)argvec->len, onTag, dcTag, (uint8_t)values->len);
+}
+
+void McCluskeyInput_make(McCluskeyInput_t * restrict This, McCluskeyCtx_t * restrict ctx)
+{
+	memset(This, 0, sizeof(McCluskeyInput_t));
+	This->ctx = ctx;
+	McCluskeyCtx_setMode(ctx, '1');
+}
+void McCluskeyInput_resume(McCluskeyInput_t * restrict This, McCluskeyCtx_t * restrict ctx, const McCluskeyVals_t * restrict table)
+{
+	memset(This, 0, sizeof(McCluskeyInput_t));
+	This->ctx       = ctx;
+	This->n_inputs  = (table->n_vals > 0) ? table->lens[0] : 0;
+	This->n_outputs = table->n_outputs;
+	This->started   = true;
+}
+bool McCluskeyInput_parseLine(
+	McCluskeyInput_t * restrict This,
+	const char * restrict line,
+	size_t len,
+	McCluskeyVals_t * restrict vals,
+	bool * restrict valid
+)
+{
+	*valid = false;
+	const bool first = (This->started == false);
+	This->started = true;
+
+	size_t pos = 0;
+	McCluskeyToken_t tok = { 0 }, next = { 0 };
+	if (McCluskeyInput_nextToken(line, len, &pos, &tok) == false)
+	{
+		return true;
+	}
+	const bool hasNext = McCluskeyInput_nextToken(line, len, &pos, &next);
+
+	if (tok.str[0] == '#')
+	{
+		*valid = true;
+		return true;
+	}
+	else if (tok.str[0] == '.')
+	{
+		return McCluskeyInput_directive(This, tok.str, len - (size_t)(tok.str - line), valid);
+	}
+	else if (tok.len >= 4 && memcmp(tok.str, "mode", 4) == 0)
+	{
+		if (first && hasNext && next.len == 1)
+		{
+			McCluskeyCtx_setMode(This->ctx, next.str[0]);
+			*valid = true;
+		}
+		return true;
+	}
+	else if (tok.len >= 2 && tok.str[1] == '(')
+	{
+		return McCluskeyInput_lists(This, first, tok.str, len - (size_t)(tok.str - line), vals, valid);
+	}
+	else if (tok.len >= 2 && tok.str[0] == '0' && (tok.str[1] == 'x' || tok.str[1] == 'X'))
+	{
+		return McCluskeyInput_hex(This, tok.str, len - (size_t)(tok.str - line), vals, valid);
+	}
+	else if (hasNext == false)
+	{
+		return McCluskeyInput_bitString(This, &tok, vals, valid);
+	}
+	else
+	{
+		return McCluskeyInput_row(This, &tok, &next, vals, valid);
+	}
+}
+
+bool McCluskeyInputMap_open(McCluskeyInputMap_t * restrict This, const char * restrict path)
+{
+	memset(This, 0, sizeof(McCluskeyInputMap_t));
+#ifdef _WIN32
+	This->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	LARGE_INTEGER size;
+	if (This->file == INVALID_HANDLE_VALUE || GetFileSizeEx(This->file, &size) == FALSE)
+	{
+		if (This->file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(This->file);
+		}
+		return false;
+	}
+	This->size = (size_t)size.QuadPart;
+	if (This->size == 0)
+	{
+		return true;
+	}
+	This->mapping = CreateFileMappingA(This->file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (This->mapping == NULL)
+	{
+		CloseHandle(This->file);
+		return false;
+	}
+	This->data = MapViewOfFile(This->mapping, FILE_MAP_READ, 0, 0, 0);
+	if (This->data == NULL)
+	{
+		CloseHandle(This->mapping);
+		CloseHandle(This->file);
+		return false;
+	}
+#else
+	const int fd = open(path, O_RDONLY);
+	struct stat st;
+	if (fd < 0 || fstat(fd, &st) != 0)
+	{
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+		return false;
+	}
+	This->size = (size_t)st.st_size;
+	if (This->size > 0)
+	{
+		void * mem = mmap(NULL, This->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mem == MAP_FAILED)
+		{
+			close(fd);
+			return false;
+		}
+		This->data = mem;
+	}
+	// Mapping stays valid after closing the file
+	close(fd);
+#endif
+	return true;
+}
+void McCluskeyInputMap_close(McCluskeyInputMap_t * restrict This)
+{
+#ifdef _WIN32
+	if (This->data != NULL)
+	{
+		UnmapViewOfFile(This->data);
+		CloseHandle(This->mapping);
+	}
+	CloseHandle(This->file);
+#else
+	if (This->data != NULL)
+	{
+		munmap((void *)This->data, This->size);
+	}
+#endif
+	This->data = NULL;
+	This->size = 0;
+}
+
+// Chunks smaller than this are not worth a task of their own
+#define MCCLUSKEYINPUT_MIN_CHUNK (1 << 20)
+
+///
+///	@brief Line-aligned part of the input file and the nodes parsed from it
+///
+typedef struct McCluskeyInputChunk
+{
+	const char * begin, * end;
+
+	McCluskeyVal_t * vals;
+	size_t n_vals, cap_vals;
+	// Number of nodes per number of ones, turned into destination offsets before
+	// scattering
+	size_t buckets[MCCLUSKEYVAL_MAX_ARGVEC + 1];
+
+	size_t n_invalid;
+	// Number of outputs set by the first row
+	uint8_t n_outputs;
+	// Whether the chunk has lines that aren't argument vector rows
+	bool fallback;
+
+} McCluskeyInputChunk_t;
+
+///
+///	@brief Parses an argument vector row of a chunk
+///	@returns Whether the operation was successful
+///
+static inline bool McCluskeyInputChunk_row(McCluskeyInputChunk_t * restrict This, const char * restrict line, size_t len)
+{
+	size_t pos = 0;
+	McCluskeyToken_t argvec = { 0 }, values = { 0 };
+	McCluskeyInput_nextToken(line, len, &pos, &argvec);
+	const char first = argvec.str[0];
+	// Anything else than "[argument vector] [values] ..." is left to the line parser
+	if ((first != '0' && first != '1' && first != '-') ||
+		(argvec.len >= 2 && (argvec.str[1] == 'x' || argvec.str[1] == 'X' || argvec.str[1] == '(')) ||
+		McCluskeyInput_nextToken(line, len, &pos, &values) == false
+	)
+	{
+		This->fallback = true;
+		return true;
+	}
+
+	McCluskeyMask_t ones, dashes, onTag, dcTag;
+	if (argvec.len > MCCLUSKEYVAL_MAX_ARGVEC || values.len > MCCLUSKEYVAL_MAX_OUTPUTS ||
+		(This->n_outputs != 0 && values.len != This->n_outputs) ||
+		McCluskeyScan_parseChars(argvec.str, argvec.len, &ones, &dashes) == false ||
+		McCluskeyScan_parseChars(values.str, values.len, &onTag, &dcTag) == false ||
+		(onTag | dcTag) == 0
+	)
+	{
+		++This->n_invalid;
+		return true;
+	}
+	This->n_outputs = (uint8_t)values.len;
+
+	if (This->n_vals >= This->cap_vals)
+	{
+		const size_t newcap = (This->cap_vals == 0) ? 256 : (This->cap_vals * 2);
+		McCluskeyVal_t * mem = realloc(This->vals, sizeof(McCluskeyVal_t) * newcap);
+		if (mem == NULL)
+		{
+			return false;
+		}
+		This->vals     = mem;
+		This->cap_vals = newcap;
+	}
+	McCluskeyVal_t * val = &This->vals[This->n_vals];
+	++This->n_vals;
+	// Store the argument vector backwards
+	val->ones      = McCluskeyMask_reverse(ones, (uint8_t)argvec.len);
+	val->dashes    = McCluskeyMask_reverse(dashes, (uint8_t)argvec.len);
+	val->onTag     = (McCluskeyTag_t)onTag;
+	val->dcTag     = (McCluskeyTag_t)dcTag;
+	val->len       = (uint8_t)argvec.len;
+	val->numOnes   = McCluskeyMask_popcount(ones);
+	val->n_outputs = (uint8_t)values.len;
+	val->state     = (onTag != 0) ? McCluskeyState_one : McCluskeyState_undefined;
+	++This->buckets[val->numOnes];
+
+	return true;
+}
+///
+///	@brief Parses all lines of a chunk, stops early if the file needs the line parser
+///
+static bool McCluskeyInputChunk_parse_task(MCPool_t * pool, size_t worker, const MCPoolTask_t * task, void * user)
+{
+	(void)pool;
+	(void)worker;
+	McCluskeyInputChunk_t * This = &((McCluskeyInputChunk_t *)user)[task->args[0]];
+
+	const char * line = This->begin;
+	while (line < This->end && This->fallback == false)
+	{
+		const char * lineEnd = memchr(line, '\n', (size_t)(This->end - line));
+		lineEnd = (lineEnd == NULL) ? This->end : lineEnd;
+
+		size_t len = (size_t)(lineEnd - line);
+		while (len > 0 && line[len - 1] == '\r')
+		{
+			--len;
+		}
+
+		size_t pos = 0;
+		McCluskeyToken_t tok;
+		if (len > 0 && McCluskeyInput_nextToken(line, len, &pos, &tok) == false)
+		{
+			++This->n_invalid;
+		}
+		else if (len > 0 && McCluskeyInputChunk_row(This, line, len) == false)
+		{
+			return false;
+		}
+		line = lineEnd + 1;
+	}
+	return true;
+}
+///
+///	@brief Copies the nodes of a chunk to their sorted positions
+///
+static bool McCluskeyInputChunk_scatter_task(MCPool_t * pool, size_t worker, const MCPoolTask_t * task, void * user)
+{
+	(void)pool;
+	(void)worker;
+	McCluskeyInputChunk_t * This = &((McCluskeyInputChunk_t *)task->args[1])[task->args[0]];
+	McCluskeyVals_t * vals = user;
+
+	for (size_t i = 0; i < This->n_vals; ++i)
+	{
+		const McCluskeyVal_t * val = &This->vals[i];
+		const size_t dst = This->buckets[val->numOnes]++;
+		vals->ones[dst]      = val->ones;
+		vals->dashes[dst]    = val->dashes;
+		vals->onTags[dst]    = val->onTag;
+		vals->dcTags[dst]    = val->dcTag;
+		vals->lens[dst]      = val->len;
+		vals->numOnes[dst]   = val->numOnes;
+		vals->states[dst]    = val->state;
+		vals->parentOff[dst] = 0;
+		vals->parentCnt[dst] = 0;
+	}
+	return true;
+}
+///
+///	@brief Parses the buffer line by line
+///
+static inline bool McCluskeyInput_parseLines(
+	McCluskeyCtx_t * restrict ctx,
+	const char * restrict data,
+	size_t size,
+	McCluskeyVals_t * restrict vals,
+	size_t * restrict n_invalid
+)
+{
+	McCluskeyInput_t input;
+	McCluskeyInput_make(&input, ctx);
+
+	const char * line = data, * end = data + size;
+	while (line < end)
+	{
+		const char * lineEnd = memchr(line, '\n', (size_t)(end - line));
+		lineEnd = (lineEnd == NULL) ? end : lineEnd;
+
+		size_t len = (size_t)(lineEnd - line);
+		while (len > 0 && line[len - 1] == '\r')
+		{
+			--len;
+		}
+		bool valid = true;
+		if (len > 0 && McCluskeyInput_parseLine(&input, line, len, vals, &valid) == false)
+		{
+			return false;
+		}
+		*n_invalid += (valid == false);
+		line = lineEnd + 1;
+	}
+	return true;
+}
+
+bool McCluskeyInput_parseBuffer(
+	McCluskeyCtx_t * restrict ctx,
+	const char * restrict data,
+	size_t size,
+	size_t n_threads,
+	McCluskeyVals_t * restrict vals,
+	size_t * restrict n_invalid,
+	bool * restrict sorted
+)
+{
+	McCluskeyCtx_setMode(ctx, '1');
+	*n_invalid = 0;
+	*sorted = false;
+	n_threads = (n_threads == 0) ? MCPool_hardwareThreads() : n_threads;
+
+	// A few chunks per thread balance uneven lines
+	size_t n_chunks = size / MCCLUSKEYINPUT_MIN_CHUNK;
+	n_chunks = (n_chunks > (n_threads * 4)) ? (n_threads * 4) : n_chunks;
+	n_chunks = (n_chunks == 0) ? 1 : n_chunks;
+
+	McCluskeyInputChunk_t * chunks = calloc(n_chunks, sizeof(McCluskeyInputChunk_t));
+	MCPoolTask_t * tasks = malloc(sizeof(MCPoolTask_t) * n_chunks);
+	if (chunks == NULL || tasks == NULL)
+	{
+		free(chunks);
+		free(tasks);
+		return false;
+	}
+
+	// Chunk boundaries are moved forward to the next line break
+	const char * begin = data, * end = data + size;
+	for (size_t i = 0; i < n_chunks; ++i)
+	{
+		const char * chunkEnd = (i + 1 == n_chunks) ? end : (data + (size / n_chunks) * (i + 1));
+		if (chunkEnd < begin)
+		{
+			chunkEnd = begin;
+		}
+		else if (chunkEnd < end)
+		{
+			const char * lineEnd = memchr(chunkEnd, '\n', (size_t)(end - chunkEnd));
+			chunkEnd = (lineEnd == NULL) ? end : (lineEnd + 1);
+		}
+		chunks[i].begin = begin;
+		chunks[i].end   = chunkEnd;
+		tasks[i] = (MCPoolTask_t){ .args = { i } };
+		begin = chunkEnd;
+	}
+
+	bool success = MCPool_run(n_threads, tasks, n_chunks, &McCluskeyInputChunk_parse_task, chunks);
+
+	// Rows of all chunks must agree on the number of outputs
+	uint8_t n_outputs = 0;
+	bool fallback = false;
+	size_t n_vals = 0;
+	for (size_t i = 0; i < n_chunks && success; ++i)
+	{
+		fallback |= chunks[i].fallback || (n_outputs != 0 && chunks[i].n_outputs != 0 && chunks[i].n_outputs != n_outputs);
+		n_outputs = (n_outputs == 0) ? chunks[i].n_outputs : n_outputs;
+		n_vals += chunks[i].n_vals;
+	}
+
+	if (success && fallback)
+	{
+		success = McCluskeyInput_parseLines(ctx, data, size, vals, n_invalid);
+	}
+	else if (success && n_vals > 0)
+	{
+		success = McCluskeyVals_reserve(vals, n_vals);
+		if (success)
+		{
+			// Bucket sizes of all chunks give the destination of every node
+			size_t offset = 0;
+			for (size_t k = 0; k <= MCCLUSKEYVAL_MAX_ARGVEC; ++k)
+			{
+				for (size_t i = 0; i < n_chunks; ++i)
+				{
+					const size_t count = chunks[i].buckets[k];
+					chunks[i].buckets[k] = offset;
+					offset += count;
+				}
+			}
+			for (size_t i = 0; i < n_chunks; ++i)
+			{
+				tasks[i] = (MCPoolTask_t){ .args = { i, (size_t)chunks } };
+				*n_invalid += chunks[i].n_invalid;
+			}
+			success = MCPool_run(n_threads, tasks, n_chunks, &McCluskeyInputChunk_scatter_task, vals);
+			vals->n_vals    = n_vals;
+			vals->n_outputs = n_outputs;
+			*sorted = true;
+			if (success && vals->index != NULL)
+			{
+				success = McCluskeyVals_buildIndex(vals);
+			}
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < n_chunks; ++i)
+		{
+			*n_invalid += chunks[i].n_invalid;
+		}
+	}
+
+	for (size_t i = 0; i < n_chunks; ++i)
+	{
+		free(chunks[i].vals);
+	}
+	free(chunks);
+	free(tasks);
+	return success;
+}
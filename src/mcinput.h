@@ -0,0 +1,123 @@
+#ifndef MC_INPUT_H
+#define MC_INPUT_H
+
+#include "mccluskey.h"
+
+///
+///	@brief Parser state of 1 truth table. Supported line formats:
+///	- "[argument vector] [values]", 1 value per output, also the cube lines of
+///	  Berkeley PLA
+///	- "mode [0/1]" on the first line
+///	- Berkeley PLA directives ".i N", ".o N", ".p N", ".type", ".ilb", ".ob",
+///	  ".e", comments starting with '#'
+///	- Minterm index lists "m(1,3,5)", maxterm index lists "M(0,2)" and don't care
+///	  index lists "d(4,6)", the number of variables is given by ".i" or the
+///	  largest index
+///	- Truth table vector as a bit string "01-10110", character i being the value
+///	  of minterm i
+///	- Truth table vectors in hex "0x6996 0x8001", 1 per output, bit i being the
+///	  value of minterm i
+///
+typedef struct McCluskeyInput
+{
+	// Context receiving the value mode
+	McCluskeyCtx_t * ctx;
+	// Number of variables set by ".i", 0 if not known
+	uint8_t n_inputs;
+	// Number of outputs set by ".o" or the first node, 0 if not known yet
+	uint8_t n_outputs;
+	// Whether a line has been parsed, "mode" is only allowed on the first line
+	bool started;
+	// Whether a PLA directive has been seen, cube lines without any '1' or '-'
+	// output are then skipped instead of being invalid
+	bool pla;
+
+} McCluskeyInput_t;
+
+///
+///	@brief Initialises the parser for a new truth table, resets the context to
+///	ones' mode
+///	@param This Pointer to parser object
+///	@param ctx Pointer to context
+///
+void McCluskeyInput_make(McCluskeyInput_t * restrict This, McCluskeyCtx_t * restrict ctx);
+///
+///	@brief Initialises the parser for further rows of a parsed truth table, such
+///	as edits, keeps the value mode of the context and requires the numbers of
+///	variables and outputs of the table
+///	@param This Pointer to parser object
+///	@param ctx Pointer to context
+///	@param table Pointer to the nodes of the table
+///
+void McCluskeyInput_resume(McCluskeyInput_t * restrict This, McCluskeyCtx_t * restrict ctx, const McCluskeyVals_t * restrict table);
+///
+///	@brief Parses 1 line of input and adds its nodes to an array of nodes
+///	@param This Pointer to parser object
+///	@param line Pointer to the line, doesn't have to be null-terminated
+///	@param len Length of the line without line break
+///	@param vals Pointer to the array receiving nodes
+///	@param valid Pointer to variable receiving whether the line was correct,
+///	nodes of an incorrect line are not added
+///	@returns Whether the operation was successful
+///
+bool McCluskeyInput_parseLine(
+	McCluskeyInput_t * restrict This,
+	const char * restrict line,
+	size_t len,
+	McCluskeyVals_t * restrict vals,
+	bool * restrict valid
+);
+
+///
+///	@brief Read-only memory mapping of a whole input file
+///
+typedef struct McCluskeyInputMap
+{
+	const char * data;
+	size_t size;
+#ifdef _WIN32
+	void * file, * mapping;
+#endif
+
+} McCluskeyInputMap_t;
+
+///
+///	@brief Maps a file to memory, empty files are not mapped
+///	@param This Pointer to mapping object
+///	@param path File path
+///	@returns Whether the operation was successful
+///
+bool McCluskeyInputMap_open(McCluskeyInputMap_t * restrict This, const char * restrict path);
+///
+///	@brief Unmaps a file
+///	@param This Pointer to mapping object
+///
+void McCluskeyInputMap_close(McCluskeyInputMap_t * restrict This);
+
+///
+///	@brief Parses a whole input file as 1 truth table, empty lines are skipped.
+///	Files consisting only of argument vector rows in ones' mode are split into
+///	line-aligned chunks, which are parsed in parallel into per-chunk buckets by
+///	the number of ones and then scattered into vals in sorted order. Any other
+///	file is parsed line by line with McCluskeyInput_parseLine
+///	@param ctx Pointer to context receiving the value mode
+///	@param data Pointer to file contents
+///	@param size Size of file contents in bytes
+///	@param n_threads Number of threads, 0 uses all hardware threads
+///	@param vals Pointer to empty array receiving the nodes
+///	@param n_invalid Pointer to variable receiving the number of incorrect lines
+///	@param sorted Pointer to variable receiving whether the nodes are already
+///	sorted by the number of ones
+///	@returns Whether the operation was successful
+///
+bool McCluskeyInput_parseBuffer(
+	McCluskeyCtx_t * restrict ctx,
+	const char * restrict data,
+	size_t size,
+	size_t n_threads,
+	McCluskeyVals_t * restrict vals,
+	size_t * restrict n_invalid,
+	bool * restrict sorted
+);
+
+#endif
@@ -0,0 +1,460 @@
+#include "mcoutput.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <inttypes.h>
+
+#ifdef _WIN32
+	#include <io.h>
+	#include <fcntl.h>
+#endif
+
+#define MCCLUSKEYOUTPUT_VERSION 2
+
+///
+///	@brief Ensures room for n bytes in the buffer, n must not exceed the buffer size
+///
+static inline void McCluskeyOutput_reserve(McCluskeyOutput_t * restrict This, size_t n)
+{
+	if ((This->n_buf + n) > MCCLUSKEYOUTPUT_BUFFER)
+	{
+		McCluskeyOutput_flush(This);
+	}
+}
+static inline void McCluskeyOutput_putBytes(McCluskeyOutput_t * restrict This, const void * restrict data, size_t n)
+{
+	McCluskeyOutput_reserve(This, n);
+	memcpy(&This->buf[This->n_buf], data, n);
+	This->n_buf += n;
+}
+static inline void McCluskeyOutput_putStr(McCluskeyOutput_t * restrict This, const char * restrict str)
+{
+	McCluskeyOutput_putBytes(This, str, strlen(str));
+}
+static inline void McCluskeyOutput_putChar(McCluskeyOutput_t * restrict This, char ch)
+{
+	McCluskeyOutput_reserve(This, 1);
+	This->buf[This->n_buf] = ch;
+	++This->n_buf;
+}
+static inline void McCluskeyOutput_putU32(McCluskeyOutput_t * restrict This, uint32_t num)
+{
+	McCluskeyOutput_putBytes(This, &num, sizeof(uint32_t));
+}
+///
+///	@brief Writes a formatted string to the buffer, directly to the stream if
+///	it doesn't fit
+///
+static void McCluskeyOutput_vprintf(McCluskeyOutput_t * restrict This, const char * restrict format, va_list args)
+{
+	va_list copy;
+	va_copy(copy, args);
+	int len = vsnprintf(&This->buf[This->n_buf], MCCLUSKEYOUTPUT_BUFFER - This->n_buf, format, copy);
+	va_end(copy);
+	if (len >= 0 && (size_t)len >= (MCCLUSKEYOUTPUT_BUFFER - This->n_buf))
+	{
+		McCluskeyOutput_flush(This);
+		va_copy(copy, args);
+		len = vsnprintf(This->buf, MCCLUSKEYOUTPUT_BUFFER, format, copy);
+		va_end(copy);
+		if (len >= 0 && (size_t)len >= MCCLUSKEYOUTPUT_BUFFER)
+		{
+			vfprintf(This->file, format, args);
+			return;
+		}
+	}
+	This->n_buf += (len > 0) ? (size_t)len : 0;
+}
+__attribute__((format(printf, 2, 3)))
+static void McCluskeyOutput_printf(McCluskeyOutput_t * restrict This, const char * restrict format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	McCluskeyOutput_vprintf(This, format, args);
+	va_end(args);
+}
+
+bool McCluskeyOutput_make(McCluskeyOutput_t * restrict This, FILE * restrict file, McCluskeyFormat_t format, bool parents, bool stats)
+{
+	This->buf = malloc(MCCLUSKEYOUTPUT_BUFFER);
+	if (This->buf == NULL)
+	{
+		return false;
+	}
+	This->file    = file;
+	This->n_buf   = 0;
+	This->format  = format;
+	This->parents = parents;
+	This->stats   = stats;
+	This->failed  = false;
+
+	if (format == McCluskeyFormat_binary)
+	{
+#ifdef _WIN32
+		_setmode(_fileno(file), _O_BINARY);
+#endif
+		const uint8_t header[8] = {
+			'M', 'C', 'C', 'B', MCCLUSKEYOUTPUT_VERSION, (uint8_t)sizeof(McCluskeyMask_t), parents ? 1 : 0, 0
+		};
+		McCluskeyOutput_putBytes(This, header, sizeof header);
+	}
+	return true;
+}
+bool McCluskeyOutput_flush(McCluskeyOutput_t * restrict This)
+{
+	if (This->n_buf > 0 && This->failed == false &&
+		fwrite(This->buf, 1, This->n_buf, This->file) != This->n_buf
+	)
+	{
+		This->failed = true;
+	}
+	This->n_buf = 0;
+	This->failed |= (fflush(This->file) != 0);
+	return This->failed == false;
+}
+void McCluskeyOutput_destroy(McCluskeyOutput_t * restrict This)
+{
+	McCluskeyOutput_flush(This);
+	free(This->buf);
+	This->buf = NULL;
+}
+
+void McCluskeyOutput_message(McCluskeyOutput_t * restrict This, const char * restrict format, ...)
+{
+	if (This->format != McCluskeyFormat_text)
+	{
+		return;
+	}
+	va_list args;
+	va_start(args, format);
+	McCluskeyOutput_vprintf(This, format, args);
+	va_end(args);
+}
+void McCluskeyOutput_error(McCluskeyOutput_t * restrict This, const char * restrict format, ...)
+{
+	McCluskeyOutput_flush(This);
+	va_list args;
+	va_start(args, format);
+	FILE * file = (This->format == McCluskeyFormat_text) ? This->file : stderr;
+	vfprintf(file, format, args);
+	fflush(file);
+	va_end(args);
+}
+
+///
+///	@brief Writes 1 node as a text line
+///
+static inline void McCluskeyOutput_textNode(
+	McCluskeyOutput_t * restrict This,
+	const McCluskeyVals_t * restrict layer,
+	size_t idx,
+	const McCluskeyVals_t * restrict base
+)
+{
+	char arg[MCCLUSKEYVAL_MAX_ARGVEC + 1], value[MCCLUSKEYVAL_MAX_OUTPUTS + 1];
+	McCluskeyVal_t val;
+	McCluskeyVals_get(layer, idx, &val);
+	McCluskeyVal_getVecStr(&val, arg, MCCLUSKEYVAL_MAX_ARGVEC + 1);
+	McCluskeyVal_getOutStr(&val, layer->ctx, value, MCCLUSKEYVAL_MAX_OUTPUTS + 1);
+
+	// Argument vectors are right-aligned
+	for (size_t i = strlen(arg); i < MCCLUSKEYVAL_MAX_ARGVEC; ++i)
+	{
+		McCluskeyOutput_putChar(This, ' ');
+	}
+	McCluskeyOutput_putStr(This, arg);
+	McCluskeyOutput_putStr(This, " | ");
+	McCluskeyOutput_putStr(This, value);
+
+	if (This->parents)
+	{
+		McCluskeyOutput_putStr(This, " (");
+		uint32_t n_parents;
+		const uint32_t * parents = McCluskeyVals_getParents(layer, idx, &n_parents);
+		for (uint32_t j = 0; j < n_parents; ++j)
+		{
+			McCluskeyVal_t parent;
+			McCluskeyVals_get(base, parents[j], &parent);
+			if (parent.state != McCluskeyState_one)
+			{
+				McCluskeyOutput_putChar(This, '*');
+			}
+			else
+			{
+				McCluskeyVal_getVecStr(&parent, arg, MCCLUSKEYVAL_MAX_ARGVEC + 1);
+				McCluskeyOutput_putStr(This, arg);
+			}
+			if (j < n_parents - 1)
+			{
+				McCluskeyOutput_putChar(This, ',');
+			}
+		}
+		if (n_parents == 0)
+		{
+			McCluskeyOutput_putChar(This, '*');
+		}
+		McCluskeyOutput_putChar(This, ')');
+	}
+	McCluskeyOutput_putChar(This, '\n');
+}
+///
+///	@brief Writes 1 node as a JSON object
+///
+static inline void McCluskeyOutput_jsonNode(
+	McCluskeyOutput_t * restrict This,
+	const McCluskeyVals_t * restrict layer,
+	size_t idx,
+	const McCluskeyVals_t * restrict base
+)
+{
+	char arg[MCCLUSKEYVAL_MAX_ARGVEC + 1], value[MCCLUSKEYVAL_MAX_OUTPUTS + 1];
+	McCluskeyVal_t val;
+	McCluskeyVals_get(layer, idx, &val);
+	McCluskeyVal_getVecStr(&val, arg, MCCLUSKEYVAL_MAX_ARGVEC + 1);
+	McCluskeyVal_getOutStr(&val, layer->ctx, value, MCCLUSKEYVAL_MAX_OUTPUTS + 1);
+
+	McCluskeyOutput_putStr(This, "{\"term\":\"");
+	McCluskeyOutput_putStr(This, arg);
+	McCluskeyOutput_putStr(This, "\",\"outputs\":\"");
+	McCluskeyOutput_putStr(This, value);
+	McCluskeyOutput_putChar(This, '"');
+
+	if (This->parents)
+	{
+		McCluskeyOutput_putStr(This, ",\"parents\":[");
+		uint32_t n_parents;
+		const uint32_t * parents = McCluskeyVals_getParents(layer, idx, &n_parents);
+		for (uint32_t j = 0; j < n_parents; ++j)
+		{
+			McCluskeyVal_t parent;
+			McCluskeyVals_get(base, parents[j], &parent);
+			if (j > 0)
+			{
+				McCluskeyOutput_putChar(This, ',');
+			}
+			if (parent.state != McCluskeyState_one)
+			{
+				McCluskeyOutput_putStr(This, "null");
+			}
+			else
+			{
+				McCluskeyVal_getVecStr(&parent, arg, MCCLUSKEYVAL_MAX_ARGVEC + 1);
+				McCluskeyOutput_putChar(This, '"');
+				McCluskeyOutput_putStr(This, arg);
+				McCluskeyOutput_putChar(This, '"');
+			}
+		}
+		McCluskeyOutput_putChar(This, ']');
+	}
+	McCluskeyOutput_putChar(This, '}');
+}
+///
+///	@brief Writes 1 node as a binary record
+///
+static inline void McCluskeyOutput_binaryNode(
+	McCluskeyOutput_t * restrict This,
+	const McCluskeyVals_t * restrict layer,
+	size_t idx,
+	bool parents
+)
+{
+	McCluskeyOutput_putBytes(This, &layer->ones[idx], sizeof(McCluskeyMask_t));
+	McCluskeyOutput_putBytes(This, &layer->dashes[idx], sizeof(McCluskeyMask_t));
+	McCluskeyOutput_putU32(This, (uint32_t)layer->onTags[idx]);
+	McCluskeyOutput_putU32(This, (uint32_t)layer->dcTags[idx]);
+	McCluskeyOutput_putU32(This, layer->lens[idx]);
+
+	if (parents)
+	{
+		uint32_t n_parents;
+		const uint32_t * parentArr = McCluskeyVals_getParents(layer, idx, &n_parents);
+		McCluskeyOutput_putU32(This, n_parents);
+		for (uint32_t j = 0; j < n_parents; ++j)
+		{
+			McCluskeyOutput_putU32(This, parentArr[j]);
+		}
+	}
+}
+///
+///	@brief Writes all nodes of a layer in the current format
+///
+static void McCluskeyOutput_layer(
+	McCluskeyOutput_t * restrict This,
+	const McCluskeyVals_t * restrict layer,
+	const McCluskeyVals_t * restrict base
+)
+{
+	switch (This->format)
+	{
+	case McCluskeyFormat_text:
+		for (size_t i = 0; i < layer->n_vals; ++i)
+		{
+			McCluskeyOutput_textNode(This, layer, i, base);
+		}
+		break;
+	case McCluskeyFormat_json:
+		McCluskeyOutput_putChar(This, '[');
+		for (size_t i = 0; i < layer->n_vals; ++i)
+		{
+			if (i > 0)
+			{
+				McCluskeyOutput_putChar(This, ',');
+			}
+			McCluskeyOutput_jsonNode(This, layer, i, base);
+		}
+		McCluskeyOutput_putChar(This, ']');
+		break;
+	case McCluskeyFormat_binary:
+		McCluskeyOutput_putU32(This, (uint32_t)layer->n_vals);
+		for (size_t i = 0; i < layer->n_vals; ++i)
+		{
+			McCluskeyOutput_binaryNode(This, layer, i, This->parents);
+		}
+		break;
+	}
+}
+
+void McCluskeyOutput_beginTable(McCluskeyOutput_t * restrict This, size_t number, const McCluskeyVals_t * restrict base)
+{
+	if (This->format == McCluskeyFormat_json)
+	{
+		char str[32];
+		snprintf(str, sizeof str, "{\"table\":%zu", number);
+		McCluskeyOutput_putStr(This, str);
+	}
+	else if (This->format == McCluskeyFormat_binary)
+	{
+		const size_t n_base = This->parents ? base->n_vals : 0;
+		McCluskeyOutput_putU32(This, (uint32_t)n_base);
+		McCluskeyOutput_putU32(This, (base->n_outputs == 0) ? 1 : base->n_outputs);
+		for (size_t i = 0; i < n_base; ++i)
+		{
+			McCluskeyOutput_binaryNode(This, base, i, false);
+		}
+	}
+}
+void McCluskeyOutput_primes(McCluskeyOutput_t * restrict This, const McCluskeyVals_t * restrict layer, const McCluskeyVals_t * restrict base)
+{
+	if (layer == NULL)
+	{
+		// Binary format always has the count of primes
+		if (This->format == McCluskeyFormat_binary)
+		{
+			McCluskeyOutput_putU32(This, 0);
+		}
+		return;
+	}
+
+	if (This->format == McCluskeyFormat_json)
+	{
+		McCluskeyOutput_putStr(This, ",\"primes\":");
+	}
+	McCluskeyOutput_layer(This, layer, base);
+}
+void McCluskeyOutput_covers(
+	McCluskeyOutput_t * restrict This,
+	const McCluskeyVals_t * restrict layers,
+	size_t n_layers,
+	const McCluskeyVals_t * restrict base,
+	bool expired
+)
+{
+	if (This->format == McCluskeyFormat_json)
+	{
+		McCluskeyOutput_putStr(This, ",\"covers\":[");
+	}
+	else if (This->format == McCluskeyFormat_binary)
+	{
+		// Cover flags and padding
+		const uint8_t flags[4] = { expired ? 1 : 0, 0, 0, 0 };
+		McCluskeyOutput_putBytes(This, flags, sizeof flags);
+		McCluskeyOutput_putU32(This, (uint32_t)n_layers);
+	}
+
+	for (size_t i = 0; i < n_layers; ++i)
+	{
+		if (This->format == McCluskeyFormat_text)
+		{
+			McCluskeyOutput_message(This, "Tabel #%zu:\n", i + 1);
+		}
+		else if (This->format == McCluskeyFormat_json && i > 0)
+		{
+			McCluskeyOutput_putChar(This, ',');
+		}
+		McCluskeyOutput_layer(This, &layers[i], base);
+	}
+
+	if (This->format == McCluskeyFormat_json)
+	{
+		McCluskeyOutput_putChar(This, ']');
+		if (expired)
+		{
+			McCluskeyOutput_putStr(This, ",\"optimal\":false");
+		}
+	}
+	else if (This->format == McCluskeyFormat_text && expired)
+	{
+		McCluskeyOutput_message(This, "Otsingu eelarve sai otsa, katted ei pruugi olla minimaalsed!\n");
+	}
+}
+void McCluskeyOutput_stats(McCluskeyOutput_t * restrict This, const McCluskeyStats_t * restrict stats)
+{
+	if (This->stats == false || This->format == McCluskeyFormat_binary)
+	{
+		return;
+	}
+
+	const size_t n_layers = (stats->n_layers < (MCCLUSKEYVAL_MAX_ARGVEC + 2)) ? stats->n_layers : (MCCLUSKEYVAL_MAX_ARGVEC + 2);
+	const double avgProbe = (stats->probes > 0) ? (double)stats->probeLength / (double)stats->probes : 0.0;
+	if (This->format == McCluskeyFormat_text)
+	{
+		McCluskeyOutput_printf(This,
+			"Statistika:\n"
+			"  V6rdlusi: %" PRIu64 ", yhendamisi: %" PRIu64 ", korduvaid: %" PRIu64 ", korduvaid ridu: %" PRIu64 "\n"
+			"  Intervalle kihtides:",
+			stats->comparisons, stats->merges, stats->duplicates, stats->duplicateRows
+		);
+		for (size_t i = 0; i < n_layers; ++i)
+		{
+			McCluskeyOutput_printf(This, " %zu", stats->layerNodes[i]);
+		}
+		McCluskeyOutput_printf(This,
+			"\n"
+			"  Algimplikante: %zu, olulisi: %zu\n"
+			"  Katte otsingu s6lmi: %" PRIu64 ", leitud katteid: %" PRIu64 ", minimaalseid: %zu (%zu termi)\n"
+			"  R2sitabeli proovimisi: %.2f keskmiselt, %" PRIu64 " kuni\n"
+			"  Skaneerimise tuum: %s\n",
+			stats->n_primes, stats->n_essential,
+			stats->coverNodes, stats->coversFound, stats->n_covers, stats->coverSize,
+			avgProbe, stats->maxProbe,
+			(stats->kernel != NULL) ? stats->kernel : "puudub"
+		);
+		return;
+	}
+
+	McCluskeyOutput_printf(This,
+		",\"stats\":{\"comparisons\":%" PRIu64 ",\"merges\":%" PRIu64 ",\"duplicates\":%" PRIu64
+		",\"duplicateRows\":%" PRIu64 ",\"layers\":[",
+		stats->comparisons, stats->merges, stats->duplicates, stats->duplicateRows
+	);
+	for (size_t i = 0; i < n_layers; ++i)
+	{
+		McCluskeyOutput_printf(This, (i > 0) ? ",%zu" : "%zu", stats->layerNodes[i]);
+	}
+	McCluskeyOutput_printf(This,
+		"],\"primes\":%zu,\"essential\":%zu,\"coverNodes\":%" PRIu64 ",\"coversFound\":%" PRIu64
+		",\"covers\":%zu,\"coverSize\":%zu,\"probes\":%" PRIu64 ",\"probeLength\":%" PRIu64
+		",\"maxProbe\":%" PRIu64 ",\"kernel\":\"%s\"}",
+		stats->n_primes, stats->n_essential, stats->coverNodes, stats->coversFound,
+		stats->n_covers, stats->coverSize, stats->probes, stats->probeLength, stats->maxProbe,
+		(stats->kernel != NULL) ? stats->kernel : "none"
+	);
+}
+void McCluskeyOutput_endTable(McCluskeyOutput_t * restrict This)
+{
+	if (This->format == McCluskeyFormat_json)
+	{
+		McCluskeyOutput_putStr(This, "}\n");
+	}
+}
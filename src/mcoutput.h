@@ -0,0 +1,140 @@
+#ifndef MC_OUTPUT_H
+#define MC_OUTPUT_H
+
+#include "mccluskey.h"
+
+#include <stdio.h>
+
+///
+///	@brief Enumerator to denote the format of results
+///
+typedef enum McCluskeyFormat
+{
+	// Human-readable tables and progress messages
+	McCluskeyFormat_text,
+	// 1 JSON object per truth table and line:
+	// {"table":1,"primes":[TERM,...],"covers":[[TERM,...],...]}
+	// TERM: {"term":"0-1","outputs":"1","parents":["001",null,...]}, null parents
+	// being don't care rows. "primes" is absent for the Espresso engine,
+	// "parents" is absent when parents are not written. "optimal":false follows
+	// "covers" when the cover search ran out of its budget
+	McCluskeyFormat_json,
+	// Compact binary format, all integers in host byte order:
+	// file header: "MCCB", uint8 version (2), uint8 mask size in bytes,
+	//   uint8 flags (1 = parents written), uint8 0
+	// per table:   uint32 number of base rows (0 if parents aren't written),
+	//   uint32 number of outputs, base rows as NODEs without parents,
+	//   uint32 number of primes (0 for Espresso engine), prime NODEs,
+	//   uint8 cover flags (1 = the cover search ran out of its budget, covers
+	//   aren't proven minimum), uint8 0 x 3, uint32 number of covers, per cover
+	//   uint32 number of terms and term NODEs
+	// NODE:        mask ones, mask dashes, uint32 output tag of '1',
+	//   uint32 output tag of '-', uint32 number of variables, if parents are
+	//   written: uint32 number of parents, uint32 base row index per parent
+	McCluskeyFormat_binary,
+
+} McCluskeyFormat_t;
+
+#define MCCLUSKEYOUTPUT_BUFFER (1 << 20)
+
+///
+///	@brief Buffered writer of results
+///
+typedef struct McCluskeyOutput
+{
+	FILE * file;
+	char * buf;
+	size_t n_buf;
+
+	McCluskeyFormat_t format;
+	bool parents;
+	// Whether McCluskeyOutput_stats writes solver statistics
+	bool stats;
+	// Set on first write error, further output is discarded
+	bool failed;
+
+} McCluskeyOutput_t;
+
+///
+///	@brief Initialises the writer, writes the file header of binary format
+///	@param This Pointer to writer object
+///	@param file Output stream, switched to binary mode for binary format on Windows
+///	@param format Output format
+///	@param parents Whether parents of terms are written
+///	@param stats Whether solver statistics are written
+///	@returns Whether the operation was successful
+///
+bool McCluskeyOutput_make(McCluskeyOutput_t * restrict This, FILE * restrict file, McCluskeyFormat_t format, bool parents, bool stats);
+///
+///	@brief Writes the buffer to the output stream
+///	@param This Pointer to writer object
+///	@returns Whether all output so far has been written successfully
+///
+bool McCluskeyOutput_flush(McCluskeyOutput_t * restrict This);
+///
+///	@brief Flushes and frees the writer
+///	@param This Pointer to writer object
+///
+void McCluskeyOutput_destroy(McCluskeyOutput_t * restrict This);
+
+///
+///	@brief Writes a progress message in text format, ignored in other formats
+///	@param This Pointer to writer object
+///	@param format printf-style format string
+///
+__attribute__((format(printf, 2, 3)))
+void McCluskeyOutput_message(McCluskeyOutput_t * restrict This, const char * restrict format, ...);
+///
+///	@brief Flushes the writer and writes an error message to the output stream in
+///	text format, to stderr in other formats
+///	@param This Pointer to writer object
+///	@param format printf-style format string
+///
+__attribute__((format(printf, 2, 3)))
+void McCluskeyOutput_error(McCluskeyOutput_t * restrict This, const char * restrict format, ...);
+
+///
+///	@brief Starts the results of a truth table
+///	@param This Pointer to writer object
+///	@param number Number of the table, counting from 1
+///	@param base Base layer of the solver, parent references point to its nodes
+///
+void McCluskeyOutput_beginTable(McCluskeyOutput_t * restrict This, size_t number, const McCluskeyVals_t * restrict base);
+///
+///	@brief Writes the prime implicants of a truth table
+///	@param This Pointer to writer object
+///	@param layer Layer of prime implicants, NULL if there are none
+///	@param base Base layer of the solver
+///
+void McCluskeyOutput_primes(McCluskeyOutput_t * restrict This, const McCluskeyVals_t * restrict layer, const McCluskeyVals_t * restrict base);
+///
+///	@brief Writes the covers of a truth table
+///	@param This Pointer to writer object
+///	@param layers Array of cover layers
+///	@param n_layers Number of covers
+///	@param base Base layer of the solver
+///	@param expired Whether the cover search ran out of its budget, given by
+///	McCluskeySolver_isExpired. The JSON object then gets "optimal":false, the text a
+///	note and the binary format a cover flag
+///
+void McCluskeyOutput_covers(
+	McCluskeyOutput_t * restrict This,
+	const McCluskeyVals_t * restrict layers,
+	size_t n_layers,
+	const McCluskeyVals_t * restrict base,
+	bool expired
+);
+///
+///	@brief Writes the statistics of a truth table if enabled, as lines of text or
+///	as the "stats" member of the JSON object. The binary format has no statistics
+///	@param This Pointer to writer object
+///	@param stats Pointer to statistics given by McCluskeySolver_getStats
+///
+void McCluskeyOutput_stats(McCluskeyOutput_t * restrict This, const McCluskeyStats_t * restrict stats);
+///
+///	@brief Ends the results of a truth table
+///	@param This Pointer to writer object
+///
+void McCluskeyOutput_endTable(McCluskeyOutput_t * restrict This);
+
+#endif
@@ -0,0 +1,255 @@
+#include "mcpool.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <unistd.h>
+#endif
+
+///
+///	@brief Double-ended task queue of 1 worker, owner works on the back, thieves
+///	take from the front
+///
+typedef struct MCPoolQueue
+{
+	pthread_mutex_t lock;
+	MCPoolTask_t * tasks;
+	size_t cap_tasks, front, back;
+
+} MCPoolQueue_t;
+
+struct MCPool
+{
+	MCPoolQueue_t * queues;
+	size_t n_queues;
+
+	MCPoolFunc_t func;
+	void * user;
+
+	// Number of tasks pushed, but not yet finished
+	atomic_size_t pending;
+	atomic_bool stopping;
+};
+
+///
+///	@brief Data passed to every worker thread
+///
+typedef struct MCPoolWorker
+{
+	MCPool_t * pool;
+	size_t idx;
+
+} MCPoolWorker_t;
+
+
+size_t MCPool_hardwareThreads(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (info.dwNumberOfProcessors > 0) ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+	const long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? (size_t)n : 1;
+#endif
+}
+
+///
+///	@brief Adds task to the back of the queue
+///	@returns Whether the operation was successful
+///
+static inline bool MCPoolQueue_pushBack(MCPoolQueue_t * restrict This, const MCPoolTask_t * restrict task)
+{
+	pthread_mutex_lock(&This->lock);
+	if (This->back >= This->cap_tasks)
+	{
+		// Reclaim space freed from the front before growing
+		const size_t n_tasks = This->back - This->front;
+		if (This->front > 0)
+		{
+			memmove(This->tasks, &This->tasks[This->front], sizeof(MCPoolTask_t) * n_tasks);
+			This->front = 0;
+			This->back  = n_tasks;
+		}
+		if (This->back >= This->cap_tasks)
+		{
+			size_t newcap = (This->cap_tasks + 1) * 2;
+			MCPoolTask_t * newmem = realloc(This->tasks, sizeof(MCPoolTask_t) * newcap);
+			if (newmem == NULL)
+			{
+				pthread_mutex_unlock(&This->lock);
+				return false;
+			}
+			This->tasks     = newmem;
+			This->cap_tasks = newcap;
+		}
+	}
+	This->tasks[This->back] = *task;
+	++This->back;
+	pthread_mutex_unlock(&This->lock);
+
+	return true;
+}
+///
+///	@brief Takes a task from the back (own work) or the front (stealing) of queue
+///	@returns Whether a task was taken
+///
+static inline bool MCPoolQueue_take(MCPoolQueue_t * restrict This, MCPoolTask_t * restrict task, bool steal)
+{
+	bool taken = false;
+	pthread_mutex_lock(&This->lock);
+	if (This->front < This->back)
+	{
+		if (steal)
+		{
+			*task = This->tasks[This->front];
+			++This->front;
+		}
+		else
+		{
+			--This->back;
+			*task = This->tasks[This->back];
+		}
+		taken = true;
+	}
+	pthread_mutex_unlock(&This->lock);
+
+	return taken;
+}
+
+bool MCPool_push(MCPool_t * restrict This, size_t worker, const MCPoolTask_t * restrict task)
+{
+	atomic_fetch_add(&This->pending, 1);
+	if (MCPoolQueue_pushBack(&This->queues[worker % This->n_queues], task) == false)
+	{
+		atomic_fetch_sub(&This->pending, 1);
+		return false;
+	}
+	return true;
+}
+bool MCPool_isStopping(const MCPool_t * restrict This)
+{
+	return atomic_load_explicit(&This->stopping, memory_order_relaxed);
+}
+
+///
+///	@brief Worker loop, runs own tasks first and then steals from other workers
+///	until all tasks have finished
+///
+static void * MCPool_worker(void * arg)
+{
+	const MCPoolWorker_t * worker = arg;
+	MCPool_t * pool = worker->pool;
+
+	MCPoolTask_t task;
+	size_t victim = worker->idx;
+	while (atomic_load(&pool->pending) > 0 && !MCPool_isStopping(pool))
+	{
+		bool taken = MCPoolQueue_take(&pool->queues[worker->idx], &task, false);
+		for (size_t i = 1; !taken && i < pool->n_queues; ++i)
+		{
+			victim = (victim + 1) % pool->n_queues;
+			if (victim != worker->idx)
+			{
+				taken = MCPoolQueue_take(&pool->queues[victim], &task, true);
+			}
+		}
+
+		if (!taken)
+		{
+			// Remaining tasks are being worked on by others
+			sched_yield();
+			continue;
+		}
+
+		if (pool->func(pool, worker->idx, &task, pool->user) == false)
+		{
+			atomic_store(&pool->stopping, true);
+		}
+		atomic_fetch_sub(&pool->pending, 1);
+	}
+
+	return NULL;
+}
+
+bool MCPool_run(size_t n_threads, const MCPoolTask_t * tasks, size_t n_tasks, MCPoolFunc_t func, void * user)
+{
+	if (n_threads == 0)
+	{
+		n_threads = MCPool_hardwareThreads();
+	}
+	if (n_threads > MCPOOL_MAX_THREADS)
+	{
+		n_threads = MCPOOL_MAX_THREADS;
+	}
+	if (n_threads > n_tasks)
+	{
+		n_threads = (n_tasks > 0) ? n_tasks : 1;
+	}
+
+	MCPool_t pool = {
+		.queues   = calloc(n_threads, sizeof(MCPoolQueue_t)),
+		.n_queues = n_threads,
+		.func     = func,
+		.user     = user
+	};
+	MCPoolWorker_t * workers = malloc(sizeof(MCPoolWorker_t) * n_threads);
+	pthread_t * threads      = malloc(sizeof(pthread_t) * n_threads);
+	if (pool.queues == NULL || workers == NULL || threads == NULL)
+	{
+		free(pool.queues);
+		free(workers);
+		free(threads);
+		return false;
+	}
+	atomic_init(&pool.pending, 0);
+	atomic_init(&pool.stopping, false);
+
+	bool success = true;
+	for (size_t i = 0; i < n_threads; ++i)
+	{
+		pthread_mutex_init(&pool.queues[i].lock, NULL);
+		workers[i].pool = &pool;
+		workers[i].idx  = i;
+	}
+	for (size_t i = 0; i < n_tasks && success; ++i)
+	{
+		success = MCPool_push(&pool, i, &tasks[i]);
+	}
+
+	size_t n_started = 1;
+	if (success)
+	{
+		for (; n_started < n_threads; ++n_started)
+		{
+			if (pthread_create(&threads[n_started], NULL, &MCPool_worker, &workers[n_started]) != 0)
+			{
+				// Fewer workers steal the remaining work
+				break;
+			}
+		}
+		MCPool_worker(&workers[0]);
+		for (size_t i = 1; i < n_started; ++i)
+		{
+			pthread_join(threads[i], NULL);
+		}
+	}
+	success = success && !MCPool_isStopping(&pool);
+
+	for (size_t i = 0; i < n_threads; ++i)
+	{
+		pthread_mutex_destroy(&pool.queues[i].lock);
+		free(pool.queues[i].tasks);
+	}
+	free(pool.queues);
+	free(workers);
+	free(threads);
+
+	return success;
+}
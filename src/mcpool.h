@@ -0,0 +1,70 @@
+#ifndef MC_POOL_H
+#define MC_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define MCPOOLTASK_NUM_ARGS 4
+///
+///	@brief Most workers MCPool_run starts, larger counts are clamped
+///
+#define MCPOOL_MAX_THREADS 1024
+
+///
+///	@brief Data structure to hold 1 unit of work, the meaning of arguments is
+///	defined by the work function
+///
+typedef struct MCPoolTask
+{
+	size_t args[MCPOOLTASK_NUM_ARGS];
+
+} MCPoolTask_t;
+
+///
+///	@brief A work-stealing pool of worker threads, each worker owns a double-ended
+///	task queue and steals from the other queues once its own queue is empty
+///
+typedef struct MCPool MCPool_t;
+
+///
+///	@brief Work function executed for every task
+///	@param pool Pointer to the running pool, can be used to push new tasks
+///	@param worker Index of the worker executing the task, in range [0, n_threads)
+///	@param task Pointer to the task
+///	@param user User data given to MCPool_run
+///	@returns Whether the task was successful, the pool stops on first failure
+///
+typedef bool (*MCPoolFunc_t)(MCPool_t * pool, size_t worker, const MCPoolTask_t * task, void * user);
+
+///
+///	@returns Number of hardware threads available, at least 1
+///
+size_t MCPool_hardwareThreads(void);
+///
+///	@brief Runs all tasks on n_threads workers and waits for them to finish. The
+///	calling thread is used as worker 0, tasks are initially dealt out round-robin
+///	@param n_threads Number of workers, 0 uses MCPool_hardwareThreads, at most
+///	MCPOOL_MAX_THREADS and the number of initial tasks are started
+///	@param tasks Array of initial tasks
+///	@param n_tasks Number of initial tasks
+///	@param func Work function
+///	@param user User data passed to work function
+///	@returns Whether all tasks were successful
+///
+bool MCPool_run(size_t n_threads, const MCPoolTask_t * tasks, size_t n_tasks, MCPoolFunc_t func, void * user);
+///
+///	@brief Pushes a new task to the queue of a worker from inside a work function
+///	@param This Pointer to the running pool
+///	@param worker Index of the worker whose queue receives the task
+///	@param task Pointer to the task
+///	@returns Whether the operation was successful
+///
+bool MCPool_push(MCPool_t * restrict This, size_t worker, const MCPoolTask_t * restrict task);
+///
+///	@param This Pointer to the running pool
+///	@returns Whether a task has failed and the pool is stopping
+///
+bool MCPool_isStopping(const MCPool_t * restrict This);
+
+#endif
@@ -0,0 +1,218 @@
+#include "mcsimd.h"
+
+#if !defined(MCCLUSKEY_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && MCCLUSKEY_WIDTH <= 64
+	#define MCCLUSKEY_X86_SIMD
+	#include <immintrin.h>
+
+	// Lane operations matching the mask width, 64-bit lanes need SSE4.1 for comparison
+	#if MCCLUSKEY_WIDTH == 32
+		#define MCCLUSKEY_SSE_TARGET "sse2"
+		#define MCCLUSKEY_SSE_LANES 4
+		#define MCCLUSKEY_AVX_LANES 8
+		#define mcsimd_set1_128(x)     _mm_set1_epi32((int)(x))
+		#define mcsimd_sub_128         _mm_sub_epi32
+		#define mcsimd_cmpeq_128       _mm_cmpeq_epi32
+		#define mcsimd_movemask_128(x) _mm_movemask_ps(_mm_castsi128_ps(x))
+		#define mcsimd_set1_256(x)     _mm256_set1_epi32((int)(x))
+		#define mcsimd_sub_256         _mm256_sub_epi32
+		#define mcsimd_cmpeq_256       _mm256_cmpeq_epi32
+		#define mcsimd_movemask_256(x) _mm256_movemask_ps(_mm256_castsi256_ps(x))
+	#else
+		#define MCCLUSKEY_SSE_TARGET "sse4.1"
+		#define MCCLUSKEY_SSE_LANES 2
+		#define MCCLUSKEY_AVX_LANES 4
+		#define mcsimd_set1_128(x)     _mm_set1_epi64x((long long)(x))
+		#define mcsimd_sub_128         _mm_sub_epi64
+		#define mcsimd_cmpeq_128       _mm_cmpeq_epi64
+		#define mcsimd_movemask_128(x) _mm_movemask_pd(_mm_castsi128_pd(x))
+		#define mcsimd_set1_256(x)     _mm256_set1_epi64x((long long)(x))
+		#define mcsimd_sub_256         _mm256_sub_epi64
+		#define mcsimd_cmpeq_256       _mm256_cmpeq_epi64
+		#define mcsimd_movemask_256(x) _mm256_movemask_pd(_mm256_castsi256_pd(x))
+	#endif
+#endif
+
+#if !defined(MCCLUSKEY_NO_SIMD) && defined(__SSE2__)
+	#define MCCLUSKEY_SSE2_PARSE
+	#include <emmintrin.h>
+#endif
+
+///
+///	@brief Portable kernel, 1 node at a time
+///
+static size_t McCluskeyScan_scalar(
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes,
+	const McCluskeyMask_t * restrict onesArr,
+	const McCluskeyMask_t * restrict dashesArr,
+	size_t n,
+	uint32_t * restrict matches
+)
+{
+	size_t n_matches = 0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const McCluskeyMask_t diff = (ones ^ onesArr[i]) | (dashes ^ dashesArr[i]);
+		matches[n_matches] = (uint32_t)i;
+		n_matches += ((diff & (diff - 1)) == 0);
+	}
+	return n_matches;
+}
+
+#ifdef MCCLUSKEY_X86_SIMD
+
+///
+///	@brief Appends set bits of a lane mask as offsets to the match array
+///
+static inline size_t McCluskeyScan_emitMatches(uint32_t mask, size_t base, uint32_t * restrict matches, size_t n_matches)
+{
+	while (mask != 0)
+	{
+		matches[n_matches] = (uint32_t)(base + (size_t)__builtin_ctz(mask));
+		++n_matches;
+		mask &= mask - 1;
+	}
+	return n_matches;
+}
+
+///
+///	@brief SSE kernel, 128 bits of nodes at a time
+///
+__attribute__((target(MCCLUSKEY_SSE_TARGET)))
+static size_t McCluskeyScan_sse(
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes,
+	const McCluskeyMask_t * restrict onesArr,
+	const McCluskeyMask_t * restrict dashesArr,
+	size_t n,
+	uint32_t * restrict matches
+)
+{
+	const __m128i vOnes = mcsimd_set1_128(ones), vDashes = mcsimd_set1_128(dashes);
+	const __m128i vOne  = mcsimd_set1_128(1), vZero = _mm_setzero_si128();
+
+	size_t i = 0, n_matches = 0;
+	for (; (i + MCCLUSKEY_SSE_LANES) <= n; i += MCCLUSKEY_SSE_LANES)
+	{
+		const __m128i o = _mm_loadu_si128((const __m128i *)&onesArr[i]);
+		const __m128i d = _mm_loadu_si128((const __m128i *)&dashesArr[i]);
+		const __m128i diff = _mm_or_si128(_mm_xor_si128(o, vOnes), _mm_xor_si128(d, vDashes));
+		// diff & (diff - 1) == 0 <=> at most 1 differing variable
+		const __m128i eq = mcsimd_cmpeq_128(_mm_and_si128(diff, mcsimd_sub_128(diff, vOne)), vZero);
+		n_matches = McCluskeyScan_emitMatches((uint32_t)mcsimd_movemask_128(eq), i, matches, n_matches);
+	}
+	if (i < n)
+	{
+		const size_t tail = McCluskeyScan_scalar(ones, dashes, &onesArr[i], &dashesArr[i], n - i, &matches[n_matches]);
+		for (size_t j = 0; j < tail; ++j)
+		{
+			matches[n_matches + j] += (uint32_t)i;
+		}
+		n_matches += tail;
+	}
+	return n_matches;
+}
+///
+///	@brief AVX2 kernel, 256 bits of nodes at a time
+///
+__attribute__((target("avx2")))
+static size_t McCluskeyScan_avx2(
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes,
+	const McCluskeyMask_t * restrict onesArr,
+	const McCluskeyMask_t * restrict dashesArr,
+	size_t n,
+	uint32_t * restrict matches
+)
+{
+	const __m256i vOnes = mcsimd_set1_256(ones), vDashes = mcsimd_set1_256(dashes);
+	const __m256i vOne  = mcsimd_set1_256(1), vZero = _mm256_setzero_si256();
+
+	size_t i = 0, n_matches = 0;
+	for (; (i + MCCLUSKEY_AVX_LANES) <= n; i += MCCLUSKEY_AVX_LANES)
+	{
+		const __m256i o = _mm256_loadu_si256((const __m256i *)&onesArr[i]);
+		const __m256i d = _mm256_loadu_si256((const __m256i *)&dashesArr[i]);
+		const __m256i diff = _mm256_or_si256(_mm256_xor_si256(o, vOnes), _mm256_xor_si256(d, vDashes));
+		// diff & (diff - 1) == 0 <=> at most 1 differing variable
+		const __m256i eq = mcsimd_cmpeq_256(_mm256_and_si256(diff, mcsimd_sub_256(diff, vOne)), vZero);
+		n_matches = McCluskeyScan_emitMatches((uint32_t)mcsimd_movemask_256(eq), i, matches, n_matches);
+	}
+	if (i < n)
+	{
+		const size_t tail = McCluskeyScan_sse(ones, dashes, &onesArr[i], &dashesArr[i], n - i, &matches[n_matches]);
+		for (size_t j = 0; j < tail; ++j)
+		{
+			matches[n_matches + j] += (uint32_t)i;
+		}
+		n_matches += tail;
+	}
+	return n_matches;
+}
+
+#endif
+
+McCluskeyScanKernel_t McCluskeyScan_getKernel(void)
+{
+#ifdef MCCLUSKEY_X86_SIMD
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return &McCluskeyScan_avx2;
+	}
+	else if (__builtin_cpu_supports(MCCLUSKEY_SSE_TARGET))
+	{
+		return &McCluskeyScan_sse;
+	}
+#endif
+	return &McCluskeyScan_scalar;
+}
+const char * McCluskeyScan_getKernelName(void)
+{
+	const McCluskeyScanKernel_t kernel = McCluskeyScan_getKernel();
+#ifdef MCCLUSKEY_X86_SIMD
+	if (kernel == &McCluskeyScan_avx2)
+	{
+		return "avx2";
+	}
+	else if (kernel == &McCluskeyScan_sse)
+	{
+		return MCCLUSKEY_SSE_TARGET;
+	}
+#endif
+	(void)kernel;
+	return "scalar";
+}
+
+bool McCluskeyScan_parseChars(const char * restrict str, size_t len, McCluskeyMask_t * restrict ones, McCluskeyMask_t * restrict dashes)
+{
+	McCluskeyMask_t o = 0, d = 0;
+	size_t i = 0;
+#ifdef MCCLUSKEY_SSE2_PARSE
+	const __m128i vZero = _mm_set1_epi8('0'), vOne = _mm_set1_epi8('1'), vDash = _mm_set1_epi8('-');
+	for (; (i + 16) <= len; i += 16)
+	{
+		const __m128i c = _mm_loadu_si128((const __m128i *)&str[i]);
+		const __m128i isOne = _mm_cmpeq_epi8(c, vOne), isDash = _mm_cmpeq_epi8(c, vDash);
+		const __m128i isValid = _mm_or_si128(_mm_cmpeq_epi8(c, vZero), _mm_or_si128(isOne, isDash));
+		if (_mm_movemask_epi8(isValid) != 0xFFFF)
+		{
+			return false;
+		}
+		o |= (McCluskeyMask_t)(uint32_t)_mm_movemask_epi8(isOne) << i;
+		d |= (McCluskeyMask_t)(uint32_t)_mm_movemask_epi8(isDash) << i;
+	}
+#endif
+	for (; i < len; ++i)
+	{
+		const char ch = str[i];
+		if (ch != '0' && ch != '1' && ch != '-')
+		{
+			return false;
+		}
+		o |= (McCluskeyMask_t)(ch == '1') << i;
+		d |= (McCluskeyMask_t)(ch == '-') << i;
+	}
+	*ones   = o;
+	*dashes = d;
+	return true;
+}
@@ -0,0 +1,47 @@
+#ifndef MC_SIMD_H
+#define MC_SIMD_H
+
+#include "mccluskey.h"
+
+///
+///	@brief Kernel comparing 1 node against a run of nodes
+///	@param ones Mask of ones of the node
+///	@param dashes Mask of dashes of the node
+///	@param onesArr Array of masks of ones of compared nodes
+///	@param dashesArr Array of masks of dashes of compared nodes
+///	@param n Number of compared nodes
+///	@param matches Array of at least n elements receiving the offsets of compared
+///	nodes that differ from the node in at most 1 variable, in ascending order
+///	@returns Number of matches
+///
+typedef size_t (*McCluskeyScanKernel_t)(
+	McCluskeyMask_t ones,
+	McCluskeyMask_t dashes,
+	const McCluskeyMask_t * restrict onesArr,
+	const McCluskeyMask_t * restrict dashesArr,
+	size_t n,
+	uint32_t * restrict matches
+);
+
+///
+///	@returns The fastest comparison kernel supported by the running CPU
+///
+McCluskeyScanKernel_t McCluskeyScan_getKernel(void);
+///
+///	@returns Name of the kernel returned by McCluskeyScan_getKernel
+///
+const char * McCluskeyScan_getKernelName(void);
+
+///
+///	@brief Validates a string of '0', '1' and '-' characters and converts it to masks,
+///	16 characters at a time where SSE2 is available
+///	@param str Pointer to characters, doesn't have to be null-terminated
+///	@param len Number of characters, at most MCCLUSKEY_WIDTH
+///	@param ones Pointer to variable receiving the mask of '1' characters, bit i
+///	being set by character i
+///	@param dashes Pointer to variable receiving the mask of '-' characters
+///	@returns Whether all characters were valid
+///
+bool McCluskeyScan_parseChars(const char * restrict str, size_t len, McCluskeyMask_t * restrict ones, McCluskeyMask_t * restrict dashes);
+
+#endif